@@ -28,6 +28,7 @@ typedef struct sHashEntry {
 	const char *string;
 	langType language;
 	int value;
+	unsigned int hash;  /* full hash value, to skip most string comparisons */
 } hashEntry;
 
 /*
@@ -87,7 +88,7 @@ static unsigned int hashValue (const char *const string, langType language)
 }
 
 static hashEntry *newEntry (
-		const char *const string, langType language, int value)
+		const char *const string, langType language, int value, unsigned int hash)
 {
 	hashEntry *const entry = xMalloc (1, hashEntry);
 
@@ -95,6 +96,7 @@ static hashEntry *newEntry (
 	entry->string   = string;
 	entry->language = language;
 	entry->value    = value;
+	entry->hash     = hash;
 
 	return entry;
 }
@@ -106,13 +108,14 @@ static hashEntry *newEntry (
  */
 extern void addKeyword (const char *const string, langType language, int value)
 {
-	const unsigned int index = hashValue (string, language) % TableSize;
+	const unsigned int hash = hashValue (string, language);
+	const unsigned int index = hash % TableSize;
 	hashEntry *entry = getHashTableEntry (index);
 
 	if (entry == NULL)
 	{
 		hashEntry **const table = getHashTable ();
-		table [index] = newEntry (string, language, value);
+		table [index] = newEntry (string, language, value, hash);
 	}
 	else
 	{
@@ -131,20 +134,22 @@ extern void addKeyword (const char *const string, langType language, int value)
 		if (entry == NULL)
 		{
 			Assert (prev != NULL);
-			prev->next = newEntry (string, language, value);
+			prev->next = newEntry (string, language, value, hash);
 		}
 	}
 }
 
 static int lookupKeywordFull (const char *const string, bool caseSensitive, langType language)
 {
-	const unsigned int index = hashValue (string, language) % TableSize;
+	const unsigned int hash = hashValue (string, language);
+	const unsigned int index = hash % TableSize;
 	hashEntry *entry = getHashTableEntry (index);
 	int result = KEYWORD_NONE;
 
 	while (entry != NULL)
 	{
-		if (language == entry->language &&
+		/* the hash is case insensitive, so it also holds for lookupCaseKeyword() */
+		if (hash == entry->hash && language == entry->language &&
 			((caseSensitive && strcmp (string, entry->string) == 0) ||
 			 (!caseSensitive && strcasecmp (string, entry->string) == 0)))
 		{
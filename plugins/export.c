@@ -99,6 +99,20 @@ enum
 	DATE_TYPE_HTML
 };
 
+/* number of characters fetched from Scintilla at once */
+#define STYLED_TEXT_CHUNK_SIZE 65536
+
+/* reads characters and their styles from Scintilla in blocks, rather than using one
+ * message per character and per style */
+typedef struct
+{
+	ScintillaObject *sci;
+	gint doc_len;
+	gint start;		/* document position of the first cell in buf */
+	gint len;		/* number of cells in buf */
+	gchar *buf;		/* character/style pairs as returned by SCI_GETSTYLEDTEXT */
+} StyledTextReader;
+
 typedef void (*ExportFunc) (GeanyDocument *doc, const gchar *filename,
 	gboolean use_zoom, gboolean insert_line_numbers);
 typedef struct
@@ -115,6 +129,72 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 	gboolean use_zoom, gboolean insert_line_numbers);
 
 
+static void styled_text_reader_init(StyledTextReader *reader, ScintillaObject *sci)
+{
+	reader->sci = sci;
+	reader->doc_len = sci_get_length(sci);
+	reader->start = 0;
+	reader->len = 0;
+	reader->buf = g_malloc(STYLED_TEXT_CHUNK_SIZE * 2 + 2);
+}
+
+
+static void styled_text_reader_free(StyledTextReader *reader)
+{
+	g_free(reader->buf);
+	reader->buf = NULL;
+}
+
+
+/* makes sure pos is inside the buffered range, returns FALSE if pos is out of the document */
+static gboolean styled_text_reader_seek(StyledTextReader *reader, gint pos)
+{
+	struct Sci_TextRange tr;
+	gint end_styled;
+
+	if (pos < 0 || pos >= reader->doc_len)
+		return FALSE;
+	if (pos >= reader->start && pos < reader->start + reader->len)
+		return TRUE;
+
+	tr.chrg.cpMin = pos;
+	tr.chrg.cpMax = MIN(pos + STYLED_TEXT_CHUNK_SIZE, reader->doc_len);
+	tr.lpstrText = reader->buf;
+
+	/* text below the view may not be styled yet, see SCI_SETIDLESTYLING */
+	end_styled = scintilla_send_message(reader->sci, SCI_GETENDSTYLED, 0, 0);
+	if (end_styled < tr.chrg.cpMax)
+	{
+		gint line = scintilla_send_message(reader->sci, SCI_LINEFROMPOSITION, end_styled, 0);
+
+		scintilla_send_message(reader->sci, SCI_COLOURISE,
+			scintilla_send_message(reader->sci, SCI_POSITIONFROMLINE, line, 0), tr.chrg.cpMax);
+	}
+	scintilla_send_message(reader->sci, SCI_GETSTYLEDTEXT, 0, (sptr_t) &tr);
+
+	reader->start = pos;
+	reader->len = tr.chrg.cpMax - tr.chrg.cpMin;
+	return TRUE;
+}
+
+
+/* like sci_get_char_at(), returns 0 if pos is out of the document */
+static gchar styled_text_reader_get_char(StyledTextReader *reader, gint pos)
+{
+	if (! styled_text_reader_seek(reader, pos))
+		return 0;
+	return reader->buf[(pos - reader->start) * 2];
+}
+
+
+static gint styled_text_reader_get_style(StyledTextReader *reader, gint pos)
+{
+	if (! styled_text_reader_seek(reader, pos))
+		return 0;
+	return (guchar) reader->buf[(pos - reader->start) * 2 + 1];
+}
+
+
 /* converts a RGB colour into a LaTeX compatible representation, taken from SciTE */
 static gchar* get_tex_rgb(gint rgb_colour)
 {
@@ -362,11 +442,11 @@ static gint get_line_number_width(GeanyDocument *doc)
 static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 	gboolean use_zoom, gboolean insert_line_numbers)
 {
-	GeanyEditor *editor = doc->editor;
 	ScintillaObject *sci = doc->editor->sci;
-	gint i, doc_len, style = -1, old_style = 0, column = 0;
-	gint k, line_number, line_number_width, line_number_max_width = 0, pad;
+	gint i, doc_len, style = -1, old_style = 0, column = 0, tab_width;
+	gint k, line_number = 1, line_number_width, line_number_max_width = 0, pad;
 	gchar c, c_next, *tmp, *date;
+	StyledTextReader reader;
 	/* 0 - fore, 1 - back, 2 - bold, 3 - italic, 4 - font size, 5 - used(0/1) */
 	gint styles[STYLE_MAX + 1][MAX_TYPES];
 	gboolean block_open = FALSE;
@@ -389,17 +469,18 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 
 	/* read the document and write the LaTeX code */
 	body = g_string_new("");
-	doc_len = sci_get_length(sci);
+	tab_width = sci_get_tab_width(sci);
+	styled_text_reader_init(&reader, sci);
+	doc_len = reader.doc_len;
 	for (i = 0; i < doc_len; i++)
 	{
-		style = sci_get_style_at(sci, i);
-		c = sci_get_char_at(sci, i);
-		c_next = sci_get_char_at(sci, i + 1);
+		style = styled_text_reader_get_style(&reader, i);
+		c = styled_text_reader_get_char(&reader, i);
+		c_next = styled_text_reader_get_char(&reader, i + 1);
 
 		/* line numbers */
 		if (insert_line_numbers && column == 0)
 		{
-			line_number = sci_get_line_from_position(sci, i) + 1;
 			line_number_width = get_line_numbers_arity(line_number);
 			/* padding */
 			pad = line_number_max_width - line_number_width;
@@ -441,11 +522,11 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 				}
 				g_string_append(body, " \\\\\n");
 				column = -1;
+				line_number++;
 				break;
 			}
 			case '\t':
 			{
-				gint tab_width = sci_get_tab_width(editor->sci);
 				gint tab_stop = tab_width - (column % tab_width);
 
 				column += tab_stop - 1; /* -1 because we add 1 at the end of the loop */
@@ -509,6 +590,7 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 		g_string_append(body, "}\n");
 		block_open = FALSE;
 	}
+	styled_text_reader_free(&reader);
 
 	/* force writing of style 0 (used at least for line breaks) */
 	styles[0][USED] = 1;
@@ -545,10 +627,12 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 	date = get_date(DATE_TYPE_DEFAULT);
 	/* write all */
 	latex = g_string_new(TEMPLATE_LATEX);
-	utils_string_replace_all(latex, "{export_content}", body->str);
 	utils_string_replace_all(latex, "{export_styles}", cmds->str);
 	utils_string_replace_all(latex, "{export_date}", date);
 	utils_string_replace_all(latex, "{export_filename}", DOC_FILENAME(doc));
+	/* insert the content last, so it is neither searched for nor affected by the
+	 * other placeholders */
+	utils_string_replace_first(latex, "{export_content}", body->str);
 
 	write_data(filename, latex->str);
 
@@ -562,11 +646,11 @@ static void write_latex_file(GeanyDocument *doc, const gchar *filename,
 static void write_html_file(GeanyDocument *doc, const gchar *filename,
 	gboolean use_zoom, gboolean insert_line_numbers)
 {
-	GeanyEditor *editor = doc->editor;
 	ScintillaObject *sci = doc->editor->sci;
-	gint i, doc_len, style = -1, old_style = 0, column = 0;
-	gint k, line_number, line_number_width, line_number_max_width = 0, pad;
+	gint i, doc_len, style = -1, old_style = 0, column = 0, tab_width;
+	gint k, line_number = 1, line_number_width, line_number_max_width = 0, pad;
 	gchar c, c_next, *date, *doc_filename;
+	StyledTextReader reader;
 	/* 0 - fore, 1 - back, 2 - bold, 3 - italic, 4 - font size, 5 - used(0/1) */
 	gint styles[STYLE_MAX + 1][MAX_TYPES];
 	gboolean span_open = FALSE;
@@ -601,18 +685,19 @@ static void write_html_file(GeanyDocument *doc, const gchar *filename,
 
 	/* read the document and write the HTML body */
 	body = g_string_new("");
-	doc_len = sci_get_length(sci);
+	tab_width = sci_get_tab_width(sci);
+	styled_text_reader_init(&reader, sci);
+	doc_len = reader.doc_len;
 	for (i = 0; i < doc_len; i++)
 	{
-		style = sci_get_style_at(sci, i);
-		c = sci_get_char_at(sci, i);
-		/* sci_get_char_at() takes care of index boundaries and return 0 if i is too high */
-		c_next = sci_get_char_at(sci, i + 1);
+		style = styled_text_reader_get_style(&reader, i);
+		c = styled_text_reader_get_char(&reader, i);
+		/* the reader takes care of index boundaries and returns 0 if i is too high */
+		c_next = styled_text_reader_get_char(&reader, i + 1);
 
 		/* line numbers */
 		if (insert_line_numbers && column == 0)
 		{
-			line_number = sci_get_line_from_position(sci, i) + 1;
 			line_number_width = get_line_numbers_arity(line_number);
 			/* padding */
 			pad = line_number_max_width - line_number_width;
@@ -653,12 +738,12 @@ static void write_html_file(GeanyDocument *doc, const gchar *filename,
 				}
 				g_string_append(body, "<br />\n");
 				column = -1;
+				line_number++;
 				break;
 			}
 			case '\t':
 			{
 				gint j;
-				gint tab_width = sci_get_tab_width(editor->sci);
 				gint tab_stop = tab_width - (column % tab_width);
 
 				column += tab_stop - 1; /* -1 because we add 1 at the end of the loop */
@@ -697,6 +782,7 @@ static void write_html_file(GeanyDocument *doc, const gchar *filename,
 		g_string_append(body, "</span>");
 		span_open = FALSE;
 	}
+	styled_text_reader_free(&reader);
 
 	/* write used styles in the header */
 	css = g_string_new("");
@@ -721,9 +807,11 @@ static void write_html_file(GeanyDocument *doc, const gchar *filename,
 	/* write all */
 	html = g_string_new(TEMPLATE_HTML);
 	utils_string_replace_all(html, "{export_date}", date);
-	utils_string_replace_all(html, "{export_content}", body->str);
 	utils_string_replace_all(html, "{export_styles}", css->str);
 	utils_string_replace_all(html, "{export_filename}", doc_filename);
+	/* insert the content last, so it is neither searched for nor affected by the
+	 * other placeholders */
+	utils_string_replace_first(html, "{export_content}", body->str);
 
 	write_data(filename, html->str);
 
@@ -136,7 +136,11 @@ class SurfaceImpl : public Surface {
 	PangoLayout *layout;
 	Converter conv;
 	int characterSet;
+	// Advance widths in Pango units of fonts whose printable ASCII characters all have
+	// the same width, or 0. Depends on the Pango context so only valid for this surface.
+	std::map<const FontHandle *, int> asciiAdvances;
 	void SetConverter(int characterSet_);
+	int AsciiAdvance(FontHandle *pfont);
 public:
 	SurfaceImpl();
 	~SurfaceImpl() override;
@@ -272,6 +276,7 @@ void SurfaceImpl::Clear() {
 	pcontext = 0;
 	conv.Close();
 	characterSet = -1;
+	asciiAdvances.clear();
 	x = 0;
 	y = 0;
 	inited = false;
@@ -759,10 +764,69 @@ public:
 	}
 };
 
+// Returns the advance width shared by all printable ASCII characters of the font, or 0 if
+// they differ or if some of them are shaped together, so positions of pure ASCII text
+// can be calculated without laying it out.
+int SurfaceImpl::AsciiAdvance(FontHandle *pfont) {
+	std::map<const FontHandle *, int>::const_iterator it = asciiAdvances.find(pfont);
+	if (it != asciiAdvances.end())
+		return it->second;
+
+	const int lenProbe = 0x7f - ' ';
+	char probe[lenProbe];
+	for (int i = 0; i < lenProbe; i++) {
+		probe[i] = static_cast<char>(' ' + i);
+	}
+	pango_layout_set_font_description(layout, pfont->pfd);
+	pango_layout_set_text(layout, probe, lenProbe);
+
+	int advance = 0;
+	int clusters = 0;
+	bool uniform = true;
+	PangoLayoutIter *iter = pango_layout_get_iter(layout);
+	do {
+		PangoRectangle pos;
+		pango_layout_iter_get_cluster_extents(iter, NULL, &pos);
+		if (clusters == 0)
+			advance = pos.width;
+		if ((pango_layout_iter_get_index(iter) != clusters) ||
+			(pos.width != advance) || (pos.x != clusters * advance)) {
+			uniform = false;
+			break;
+		}
+		clusters++;
+	} while (pango_layout_iter_next_cluster(iter));
+	pango_layout_iter_free(iter);
+
+	if (!uniform || (clusters != lenProbe) || (advance <= 0))
+		advance = 0;
+	asciiAdvances[pfont] = advance;
+	return advance;
+}
+
+static bool IsPrintableASCII(const char *s, int len) {
+	for (int i = 0; i < len; i++) {
+		if (s[i] < ' ' || s[i] > '~')
+			return false;
+	}
+	return true;
+}
+
 void SurfaceImpl::MeasureWidths(Font &font_, const char *s, int len, XYPOSITION *positions) {
 	if (font_.GetID()) {
 		const int lenPositions = len;
 		if (PFont(font_)->pfd) {
+			if (et == UTF8 && IsPrintableASCII(s, len)) {
+				// Fast path for fixed width fonts: all characters are a single cluster
+				// of the same width so the positions are the same Pango would return.
+				const int advance = AsciiAdvance(PFont(font_));
+				if (advance > 0) {
+					for (int i = 0; i < len; i++) {
+						positions[i] = doubleFromPangoUnits((i + 1) * advance);
+					}
+					return;
+				}
+			}
 			pango_layout_set_font_description(layout, PFont(font_)->pfd);
 			if (et == UTF8) {
 				// Simple and direct as UTF-8 is native Pango encoding
@@ -1223,6 +1287,7 @@ public:
 	int CaretFromEdge() override;
 	void Clear() override;
 	void Append(char *s, int type = -1) override;
+	void AppendToStore(GtkListStore *store, const char *s, int type);
 	int Length() override;
 	void Select(int n) override;
 	int GetSelection() override;
@@ -1659,20 +1724,23 @@ static void init_pixmap(ListImage *list_image) {
 #define SPACING 5
 
 void ListBoxX::Append(char *s, int type) {
+	GtkListStore *store =
+		GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(list)));
+	AppendToStore(store, s, type);
+}
+
+void ListBoxX::AppendToStore(GtkListStore *store, const char *s, int type) {
 	ListImage *list_image = NULL;
 	if ((type >= 0) && pixhash) {
 		list_image = static_cast<ListImage *>(g_hash_table_lookup((GHashTable *) pixhash
 		             , (gconstpointer) GINT_TO_POINTER(type)));
 	}
 	GtkTreeIter iter;
-	GtkListStore *store =
-		GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(list)));
-	gtk_list_store_append(GTK_LIST_STORE(store), &iter);
 	if (list_image) {
 		if (NULL == list_image->pixbuf)
 			init_pixmap(list_image);
 		if (list_image->pixbuf) {
-			gtk_list_store_set(GTK_LIST_STORE(store), &iter,
+			gtk_list_store_insert_with_values(store, &iter, -1,
 								PIXBUF_COLUMN, list_image->pixbuf,
 								TEXT_COLUMN, s, -1);
 
@@ -1684,11 +1752,11 @@ void ListBoxX::Append(char *s, int type) {
 				gtk_cell_renderer_set_fixed_size(pixbuf_renderer,
 								pixbuf_width, -1);
 		} else {
-			gtk_list_store_set(GTK_LIST_STORE(store), &iter,
+			gtk_list_store_insert_with_values(store, &iter, -1,
 								TEXT_COLUMN, s, -1);
 		}
 	} else {
-			gtk_list_store_set(GTK_LIST_STORE(store), &iter,
+			gtk_list_store_insert_with_values(store, &iter, -1,
 								TEXT_COLUMN, s, -1);
 	}
 	size_t len = strlen(s);
@@ -1857,6 +1925,12 @@ void ListBoxX::SetDelegate(IListBoxDelegate *lbDelegate) {
 
 void ListBoxX::SetList(const char *listText, char separator, char typesep) {
 	Clear();
+	// Detach the model while filling it, otherwise the tree view handles every added row
+	// which makes showing lists with thousands of items slow
+	GtkTreeModel *model = gtk_tree_view_get_model(GTK_TREE_VIEW(list));
+	GtkListStore *store = GTK_LIST_STORE(model);
+	g_object_ref(model);
+	gtk_tree_view_set_model(GTK_TREE_VIEW(list), NULL);
 	int count = strlen(listText) + 1;
 	std::vector<char> words(listText, listText+count);
 	char *startword = &words[0];
@@ -1867,7 +1941,7 @@ void ListBoxX::SetList(const char *listText, char separator, char typesep) {
 			words[i] = '\0';
 			if (numword)
 				*numword = '\0';
-			Append(startword, numword?atoi(numword + 1):-1);
+			AppendToStore(store, startword, numword?atoi(numword + 1):-1);
 			startword = &words[0] + i + 1;
 			numword = NULL;
 		} else if (words[i] == typesep) {
@@ -1877,8 +1951,10 @@ void ListBoxX::SetList(const char *listText, char separator, char typesep) {
 	if (startword) {
 		if (numword)
 			*numword = '\0';
-		Append(startword, numword?atoi(numword + 1):-1);
+		AppendToStore(store, startword, numword?atoi(numword + 1):-1);
 	}
+	gtk_tree_view_set_model(GTK_TREE_VIEW(list), model);
+	g_object_unref(model);
 }
 
 Menu::Menu() noexcept : mid(0) {}
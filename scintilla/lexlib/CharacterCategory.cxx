@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <vector>
 
 #include "CharacterCategory.h"
 
@@ -3796,6 +3798,47 @@ const int catRanges[] = {
 const int maxUnicode = 0x10ffff;
 const int maskCategory = 0x1F;
 
+// Two level lookup table expanded from catRanges.
+// Characters are split into blocks of 256 and each block is mapped to the categories of its
+// characters. Most blocks have identical contents (such as all unassigned or all CJK ideographs)
+// so these are shared, keeping the table to about 45K.
+class CategoryTable {
+	enum { blockShift = 8, blockSize = 1 << blockShift };
+	std::vector<unsigned short> blockIndex;
+	std::vector<unsigned char> blocks;
+public:
+	CategoryTable() {
+		const int countBlocks = (maxUnicode + 1) / blockSize;
+		std::map<std::vector<unsigned char>, unsigned short> uniqueBlocks;
+		std::vector<unsigned char> block(blockSize);
+		blockIndex.reserve(countBlocks);
+		const int *range = catRanges;
+		const int *rangeNext = range + 1;
+		for (int ch = 0; ch <= maxUnicode; ch++) {
+			while ((rangeNext != std::end(catRanges)) && ((*rangeNext >> 5) <= ch)) {
+				range = rangeNext;
+				++rangeNext;
+			}
+			block[ch & (blockSize - 1)] = static_cast<unsigned char>(*range & maskCategory);
+			if ((ch & (blockSize - 1)) == (blockSize - 1)) {
+				const auto it = uniqueBlocks.find(block);
+				if (it != uniqueBlocks.end()) {
+					blockIndex.push_back(it->second);
+				} else {
+					const unsigned short index = static_cast<unsigned short>(uniqueBlocks.size());
+					uniqueBlocks[block] = index;
+					blocks.insert(blocks.end(), block.begin(), block.end());
+					blockIndex.push_back(index);
+				}
+			}
+		}
+	}
+	CharacterCategory Find(int character) const {
+		const int block = blockIndex[character >> blockShift];
+		return static_cast<CharacterCategory>(blocks[(block << blockShift) + (character & (blockSize - 1))]);
+	}
+};
+
 }
 
 // Each element in catRanges is the start of a range of Unicode characters in
@@ -3803,18 +3846,15 @@ const int maskCategory = 0x1F;
 // The value is comprised of a 21-bit character value shifted 5 bits and a 5 bit
 // category matching the CharacterCategory enumeration.
 // Initial version has 3249 entries and adds about 13K to the executable.
-// The array is in ascending order so can be searched using binary search.
-// Therefore the average call takes log2(3249) = 12 comparisons.
-// For speed, it may be useful to make a linear table for the common values,
-// possibly for 0..0xff for most Western European text or 0..0xfff for most
-// alphabetic languages.
+// The array is in ascending order so could be searched using binary search but that
+// takes log2(3249) = 12 comparisons for each call.
+// Instead, it is expanded into a CategoryTable on first use which needs only two lookups.
 
 CharacterCategory CategoriseCharacter(int character) {
 	if (character < 0 || character > maxUnicode)
 		return ccCn;
-	const int baseValue = character * (maskCategory+1) + maskCategory;
-	const int *placeAfter = std::lower_bound(catRanges, std::end(catRanges), baseValue);
-	return static_cast<CharacterCategory>(*(placeAfter-1) & maskCategory);
+	static const CategoryTable table;
+	return table.Find(character);
 }
 
 // Implementation of character sets recommended for identifiers in Unicode Standard Annex #31.
@@ -9,6 +9,8 @@
 #include <cassert>
 #include <cstring>
 
+#include <string>
+#include <map>
 #include <algorithm>
 #include <iterator>
 
@@ -16,6 +18,32 @@
 
 using namespace Scintilla;
 
+namespace Scintilla {
+
+// The parsed form of a word list, shared by all WordLists set to the same text
+// such as the keywords of each document using one language.
+struct WordListData {
+	typedef std::map<std::string, WordListData *> Shared;
+	Shared::iterator position;
+	char *list;
+	char **words;
+	int len;
+	int starts[256];
+	int references;
+};
+
+}
+
+namespace {
+
+// Allocated and never freed so WordLists may still be released during static destruction.
+WordListData::Shared &SharedWordLists(bool onlyLineEnds) {
+	static WordListData::Shared *shared = new WordListData::Shared[2];
+	return shared[onlyLineEnds ? 1 : 0];
+}
+
+}
+
 /**
  * Creates an array that points into each word in the string and puts \0 terminators
  * after each word.
@@ -62,9 +90,7 @@ static char **ArrayFromWordList(char *wordlist, int *len, bool onlyLineEnds = fa
 }
 
 WordList::WordList(bool onlyLineEnds_) :
-	words(0), list(0), len(0), onlyLineEnds(onlyLineEnds_) {
-	// Prevent warnings by static analyzers about uninitialized starts.
-	starts[0] = -1;
+	data(0), words(0), len(0), onlyLineEnds(onlyLineEnds_), starts(0) {
 }
 
 WordList::~WordList() {
@@ -76,6 +102,8 @@ WordList::operator bool() const {
 }
 
 bool WordList::operator!=(const WordList &other) const {
+	if (data == other.data)
+		return false;
 	if (len != other.len)
 		return true;
 	for (int i=0; i<len; i++) {
@@ -90,13 +118,19 @@ int WordList::Length() const {
 }
 
 void WordList::Clear() {
-	if (words) {
-		delete []list;
-		delete []words;
+	if (data) {
+		data->references--;
+		if (data->references == 0) {
+			SharedWordLists(onlyLineEnds).erase(data->position);
+			delete []data->list;
+			delete []data->words;
+			delete data;
+		}
 	}
+	data = 0;
 	words = 0;
-	list = 0;
 	len = 0;
+	starts = 0;
 }
 
 #ifdef _MSC_VER
@@ -118,21 +152,38 @@ static void SortWordList(char **words, unsigned int len) {
 #endif
 
 void WordList::Set(const char *s) {
-	Clear();
-	const size_t lenS = strlen(s) + 1;
-	list = new char[lenS];
-	memcpy(list, s, lenS);
-	words = ArrayFromWordList(list, &len, onlyLineEnds);
+	WordListData::Shared &shared = SharedWordLists(onlyLineEnds);
+	std::string text(s);
+	WordListData::Shared::iterator it = shared.find(text);
+	WordListData *dataNew;
+	if (it != shared.end()) {
+		dataNew = it->second;
+	} else {
+		dataNew = new WordListData();
+		dataNew->position = shared.insert(std::make_pair(std::move(text), dataNew)).first;
+		dataNew->references = 0;
+		const size_t lenS = strlen(s) + 1;
+		dataNew->list = new char[lenS];
+		memcpy(dataNew->list, s, lenS);
+		dataNew->words = ArrayFromWordList(dataNew->list, &dataNew->len, onlyLineEnds);
 #ifdef _MSC_VER
-	std::sort(words, words + len, cmpWords);
+		std::sort(dataNew->words, dataNew->words + dataNew->len, cmpWords);
 #else
-	SortWordList(words, len);
+		SortWordList(dataNew->words, dataNew->len);
 #endif
-	std::fill(starts, std::end(starts), -1);
-	for (int l = len - 1; l >= 0; l--) {
-		unsigned char indexChar = words[l][0];
-		starts[indexChar] = l;
+		std::fill(dataNew->starts, std::end(dataNew->starts), -1);
+		for (int l = dataNew->len - 1; l >= 0; l--) {
+			unsigned char indexChar = dataNew->words[l][0];
+			dataNew->starts[indexChar] = l;
+		}
 	}
+	// Take the reference before releasing the current data in case they are the same
+	dataNew->references++;
+	Clear();
+	data = dataNew;
+	words = data->words;
+	len = data->len;
+	starts = data->starts;
 }
 
 /** Check whether a string is in the list.
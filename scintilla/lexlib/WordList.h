@@ -10,17 +10,24 @@
 
 namespace Scintilla {
 
+struct WordListData;
+
 /**
+ * Word lists set to the same text share their parsed form.
  */
 class WordList {
+	WordListData *data;
 	// Each word contains at least one character - a empty word acts as sentinel at the end.
+	// words and starts point into data.
 	char **words;
-	char *list;
 	int len;
 	bool onlyLineEnds;	///< Delimited by any white space or only line ends
-	int starts[256];
+	const int *starts;
 public:
 	explicit WordList(bool onlyLineEnds_ = false);
+	// Deleted so WordList objects can not be copied.
+	WordList(const WordList &) = delete;
+	void operator=(const WordList &) = delete;
 	~WordList();
 	operator bool() const;
 	bool operator!=(const WordList &other) const;
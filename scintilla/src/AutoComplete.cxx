@@ -163,6 +163,7 @@ void AutoComplete::SetList(const char *list) {
 	}
 
 	std::string sortedList;
+	sortedList.reserve(strlen(list) + sortMatrix.size());
 	char item[maxItemLen];
 	for (size_t i = 0; i < sortMatrix.size(); ++i) {
 		int wordLen = IndexSort.indices[sortMatrix[i] * 2 + 2] - IndexSort.indices[sortMatrix[i] * 2];
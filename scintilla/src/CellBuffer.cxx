@@ -273,6 +273,7 @@ Action::Action() {
 	at = startAction;
 	position = 0;
 	lenData = 0;
+	lenAllocated = 0;
 	mayCoalesce = false;
 }
 
@@ -288,12 +289,36 @@ void Action::Create(actionType at_, Sci::Position position_, const char *data_,
 		memcpy(&data[0], data_, lenData_);
 	}
 	lenData = lenData_;
+	lenAllocated = lenData_;
 	mayCoalesce = mayCoalesce_;
 }
 
 void Action::Clear() {
 	data = nullptr;
 	lenData = 0;
+	lenAllocated = 0;
+}
+
+// Add text to the start or end of the data, growing the allocation geometrically so that
+// a long run of typing does not copy the whole run for each character.
+// Returns a pointer to the newly added text.
+const char *Action::Extend(const char *data_, Sci::Position lenData_, bool atStart) {
+	const Sci::Position lenNew = lenData + lenData_;
+	const Sci::Position offsetOld = atStart ? lenData_ : 0;
+	if (lenNew > lenAllocated) {
+		const Sci::Position lenAllocate = std::max(lenNew, lenAllocated * 2);
+		std::unique_ptr<char[]> dataNew(new char[lenAllocate]);
+		if (lenData)
+			memcpy(&dataNew[offsetOld], &data[0], lenData);
+		data = std::move(dataNew);
+		lenAllocated = lenAllocate;
+	} else if (atStart) {
+		memmove(&data[offsetOld], &data[0], lenData);
+	}
+	char *added = &data[atStart ? 0 : lenData];
+	memcpy(added, data_, lenData_);
+	lenData = lenNew;
+	return added;
 }
 
 // The undo history stores a sequence of user operations that represent the user's view of the
@@ -338,6 +363,34 @@ void UndoHistory::EnsureUndoRoom() {
 	}
 }
 
+// When an action is coalesced into the current user operation and continues the text of the
+// previous action, such as typing or a run of backspaces or deletes, the previous action is
+// extended instead of recording another action. This avoids an Action and an allocation for
+// each character.
+// Returns a pointer to the recorded text or nullptr if the action could not be merged.
+const char *UndoHistory::ExtendPrevious(actionType at, Sci::Position position, const char *data, Sci::Position lengthData,
+	bool mayCoalesce) {
+	if ((currentAction < 1) || (lengthData <= 0) || !mayCoalesce)
+		return nullptr;
+	Action &actPrevious = actions[currentAction - 1];
+	if ((actPrevious.at != at) || !actPrevious.mayCoalesce)
+		return nullptr;
+	if (at == insertAction) {
+		if (position == (actPrevious.position + actPrevious.lenData))
+			return actPrevious.Extend(data, lengthData, false);
+	} else if (at == removeAction) {
+		if ((position + lengthData) == actPrevious.position) {
+			// Backspace
+			actPrevious.position = position;
+			return actPrevious.Extend(data, lengthData, true);
+		} else if (position == actPrevious.position) {
+			// Delete
+			return actPrevious.Extend(data, lengthData, false);
+		}
+	}
+	return nullptr;
+}
+
 const char *UndoHistory::AppendAction(actionType at, Sci::Position position, const char *data, Sci::Position lengthData,
 	bool &startSequence, bool mayCoalesce) {
 	EnsureUndoRoom();
@@ -402,6 +455,13 @@ const char *UndoHistory::AppendAction(actionType at, Sci::Position position, con
 		currentAction++;
 	}
 	startSequence = oldCurrentAction != currentAction;
+	if (!startSequence) {
+		const char *dataExtended = ExtendPrevious(at, position, data, lengthData, mayCoalesce);
+		if (dataExtended) {
+			maxAction = currentAction;
+			return dataExtended;
+		}
+	}
 	const int actionWithData = currentAction;
 	actions[currentAction].Create(at, position, data, lengthData, mayCoalesce);
 	currentAction++;
@@ -35,6 +35,7 @@ public:
 	Sci::Position position;
 	std::unique_ptr<char[]> data;
 	Sci::Position lenData;
+	Sci::Position lenAllocated;
 	bool mayCoalesce;
 
 	Action();
@@ -47,6 +48,7 @@ public:
 	~Action();
 	void Create(actionType at_, Sci::Position position_=0, const char *data_=nullptr, Sci::Position lenData_=0, bool mayCoalesce_=true);
 	void Clear();
+	const char *Extend(const char *data_, Sci::Position lenData_, bool atStart);
 };
 
 /**
@@ -61,6 +63,7 @@ class UndoHistory {
 	int tentativePoint;
 
 	void EnsureUndoRoom();
+	const char *ExtendPrevious(actionType at, Sci::Position position, const char *data, Sci::Position lengthData, bool mayCoalesce);
 
 public:
 	UndoHistory();
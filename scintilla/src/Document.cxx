@@ -2008,6 +2008,32 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 		if (caseSensitive) {
 			const Sci::Position endSearch = (startPos <= endPos) ? endPos - lengthFind + 1 : endPos;
 			const char charStartSearch =  search[0];
+			if (forward && ((dbcsCodePage == 0) ||
+				((SC_CP_UTF8 == dbcsCodePage) && !UTF8IsTrailByte(charStartSearch)))) {
+				// The first byte can only match at the start of a character so look for candidates
+				// with memchr over each side of the gap instead of stepping through characters.
+				const Sci::Position gapPosition = cb.GapPosition();
+				while (pos < endSearch) {
+					const Sci::Position endSegment = (pos < gapPosition) ? std::min(gapPosition, endSearch) : endSearch;
+					const char *segment = cb.RangePointer(pos, endSegment - pos);
+					const char *candidate = static_cast<const char *>(
+						memchr(segment, charStartSearch, endSegment - pos));
+					if (!candidate) {
+						pos = endSegment;
+						continue;
+					}
+					pos += candidate - segment;
+					bool found = (pos + lengthFind) <= limitPos;
+					for (int indexSearch = 1; (indexSearch < lengthFind) && found; indexSearch++) {
+						found = CharAt(pos + indexSearch) == search[indexSearch];
+					}
+					if (found && MatchesWordOptions(word, wordStart, pos, lengthFind)) {
+						return pos;
+					}
+					pos++;
+				}
+				return -1;
+			}
 			while (forward ? (pos < endSearch) : (pos >= endSearch)) {
 				if (CharAt(pos) == charStartSearch) {
 					bool found = (pos + lengthFind) <= limitPos;
@@ -2028,7 +2054,22 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 				pcf->Fold(&searchThing[0], searchThing.size(), search, lengthFind);
 			char bytes[UTF8MaxBytes + 1] = "";
 			char folded[UTF8MaxBytes * maxFoldingExpansion + 1] = "";
+			// Which ASCII characters can start a match, so most positions are rejected
+			// without folding them
+			bool asciiStartsMatch[0x80];
+			for (int ch = 0; ch < 0x80; ch++) {
+				const char chFold = static_cast<char>(ch);
+				const size_t lenFlat = pcf->Fold(folded, sizeof(folded), &chFold, 1);
+				asciiStartsMatch[ch] = (lenFlat == 0) || (folded[0] == searchThing[0]);
+			}
 			while (forward ? (pos < endPos) : (pos >= endPos)) {
+				if (forward) {
+					const unsigned char leadByte = cb.UCharAt(pos);
+					if (UTF8IsAscii(leadByte) && !asciiStartsMatch[leadByte]) {
+						pos++;
+						continue;
+					}
+				}
 				int widthFirstCharacter = 0;
 				Sci::Position posIndexDocument = pos;
 				size_t indexSearch = 0;
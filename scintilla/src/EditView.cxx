@@ -186,6 +186,10 @@ EditView::EditView() {
 	imeCaretBlockOverride = false;
 	llc.SetLevel(LineLayoutCache::llcCaret);
 	posCache.SetSize(0x400);
+	posCacheForPrint = false;
+	posCachePrintMagnification = 0;
+	posCachePrintLogPixels = 0;
+	formattingForPrint = false;
 	tabArrowHeight = 4;
 	customDrawTabArrow = nullptr;
 	customDrawWrapMarker = nullptr;
@@ -344,6 +348,32 @@ LineLayout *EditView::RetrieveLineLayout(Sci::Line lineNumber, const EditModel &
 		model.LinesOnScreen() + 1, model.pdoc->LinesTotal());
 }
 
+/**
+* Check whether a line certainly fits in width without laying it out, using an upper
+* bound of its width. Only handles lines of printable ASCII characters and tabs.
+*/
+bool EditView::LineFitsWidth(const EditModel &model, Sci::Line line, const ViewStyle &vstyle, int width) const {
+	if (vstyle.viewEOL || ldTabstops)
+		return false;
+	const Sci::Position posLineStart = model.pdoc->LineStart(line);
+	const Sci::Position posLineEnd = model.pdoc->LineEnd(line);
+	const XYPOSITION widthTab = vstyle.tabWidth + tabWidthMinimumPixels;
+	XYPOSITION widthMax = 0;
+	for (Sci::Position pos = posLineStart; pos < posLineEnd; pos++) {
+		const char ch = model.pdoc->CharAt(pos);
+		if (ch == '\t') {
+			widthMax += widthTab;
+		} else if ((ch >= ' ') && (ch <= '~') && !model.reprs.Contains(&ch, 1)) {
+			widthMax += vstyle.maxWidthASCII;
+		} else {
+			return false;
+		}
+		if (widthMax >= width)
+			return false;
+	}
+	return true;
+}
+
 /**
 * Fill in the LineLayout data for the given line.
 * Copy the given @a line and its styles from the document into local arrays.
@@ -355,6 +385,11 @@ void EditView::LayoutLine(const EditModel &model, Sci::Line line, Surface *surfa
 
 	PLATFORM_ASSERT(line < model.pdoc->LinesTotal());
 	PLATFORM_ASSERT(ll->chars != NULL);
+	if (posCacheForPrint && !formattingForPrint) {
+		// Can't use measurements cached for printing
+		posCache.Clear();
+		posCacheForPrint = false;
+	}
 	const Sci::Position posLineStart = model.pdoc->LineStart(line);
 	Sci::Position posLineEnd = model.pdoc->LineStart(line + 1);
 	// If the line is very long, limit the treatment to a length that should fit in the viewport
@@ -2214,8 +2249,17 @@ static ColourDesired InvertedLight(ColourDesired orig) {
 
 Sci::Position EditView::FormatRange(bool draw, const Sci_RangeToFormat *pfr, Surface *surface, Surface *surfaceMeasure,
 	const EditModel &model, const ViewStyle &vs) {
-	// Can't use measurements cached for screen
-	posCache.Clear();
+	// Can't use measurements cached for screen but those from a previous page of
+	// the same print job are still valid, so pagination and drawing can share them
+	const int logPixels = surfaceMeasure->LogPixelsY();
+	if (!posCacheForPrint || (posCachePrintMagnification != printParameters.magnification) ||
+		(posCachePrintLogPixels != logPixels)) {
+		posCache.Clear();
+		posCacheForPrint = true;
+		posCachePrintMagnification = printParameters.magnification;
+		posCachePrintLogPixels = logPixels;
+	}
+	formattingForPrint = true;
 
 	ViewStyle vsPrint(vs);
 	vsPrint.technology = SC_TECHNOLOGY_DEFAULT;
@@ -2390,8 +2434,8 @@ Sci::Position EditView::FormatRange(bool draw, const Sci_RangeToFormat *pfr, Sur
 		++lineDoc;
 	}
 
-	// Clear cache so measurements are not used for screen
-	posCache.Clear();
+	// Cache is cleared by the next screen layout so measurements are not used for screen
+	formattingForPrint = false;
 
 	return nPrintPos;
 }
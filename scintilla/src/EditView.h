@@ -80,6 +80,12 @@ public:
 
 	LineLayoutCache llc;
 	PositionCache posCache;
+	/** Measurements in posCache were made for printing at this magnification and resolution
+	 * so can be reused by following FormatRange calls but not for the screen. */
+	bool posCacheForPrint;
+	int posCachePrintMagnification;
+	int posCachePrintLogPixels;
+	bool formattingForPrint;
 
 	int tabArrowHeight; // draw arrow heads this many pixels above/below line midpoint
 	/** Some platforms, notably PLAT_CURSES, do not support Scintilla's native
@@ -113,6 +119,7 @@ public:
 	void RefreshPixMaps(Surface *surfaceWindow, WindowID wid, const ViewStyle &vsDraw);
 
 	LineLayout *RetrieveLineLayout(Sci::Line lineNumber, const EditModel &model);
+	bool LineFitsWidth(const EditModel &model, Sci::Line line, const ViewStyle &vstyle, int width) const;
 	void LayoutLine(const EditModel &model, Sci::Line line, Surface *surface, const ViewStyle &vstyle,
 		LineLayout *ll, int width = LineLayout::wrapWidthInfinite);
 
@@ -1478,11 +1478,14 @@ void Editor::NeedWrapping(Sci::Line docLineStart, Sci::Line docLineEnd) {
 }
 
 bool Editor::WrapOneLine(Surface *surface, Sci::Line lineToWrap) {
-	AutoLineLayout ll(view.llc, view.RetrieveLineLayout(lineToWrap, *this));
 	int linesWrapped = 1;
-	if (ll) {
-		view.LayoutLine(*this, lineToWrap, surface, vs, ll, wrapWidth);
-		linesWrapped = ll->lines;
+	// Most lines are shorter than the wrap width: avoid laying them out when possible.
+	if (!view.LineFitsWidth(*this, lineToWrap, vs, std::max(wrapWidth, 20))) {
+		AutoLineLayout ll(view.llc, view.RetrieveLineLayout(lineToWrap, *this));
+		if (ll) {
+			view.LayoutLine(*this, lineToWrap, surface, vs, ll, wrapWidth);
+			linesWrapped = ll->lines;
+		}
 	}
 	return pcs->SetHeight(lineToWrap, linesWrapped +
 		(vs.annotationVisible ? pdoc->AnnotationLines(lineToWrap) : 0));
@@ -138,7 +138,7 @@ public:
 
 class PositionCacheEntry {
 	unsigned int styleNumber:8;
-	unsigned int len:8;
+	unsigned int len:16;
 	unsigned int clock:16;
 	std::unique_ptr<XYPOSITION []> positions;
 public:
@@ -228,6 +228,9 @@ class PositionCache {
 	unsigned int clock;
 	bool allClear;
 public:
+	// Only strings up to this length are stored in the cache. This includes the pieces
+	// long runs are subdivided into, so long lines are not measured again on each layout.
+	enum { lengthMaxCached = BreakFinder::lengthEachSubdivision };
 	PositionCache();
 	// Deleted so PositionCache objects can not be copied.
 	PositionCache(const PositionCache &) = delete;
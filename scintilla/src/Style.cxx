@@ -71,6 +71,7 @@ void FontMeasurements::ClearMeasurements() {
 	capitalHeight = 1;
 	aveCharWidth = 1;
 	spaceWidth = 1;
+	maxWidthASCII = 1;
 	sizeZoomed = 2;
 }
 
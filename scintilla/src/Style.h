@@ -49,6 +49,7 @@ struct FontMeasurements {
 	XYPOSITION capitalHeight;	// Top of capital letter to baseline: ascent - internal leading
 	XYPOSITION aveCharWidth;
 	XYPOSITION spaceWidth;
+	XYPOSITION maxWidthASCII;	// Width of the widest printable ASCII character
 	int sizeZoomed;
 	FontMeasurements();
 	void ClearMeasurements();
@@ -80,6 +80,10 @@ void FontRealised::Realise(Surface &surface, int zoomLevel, int technology, cons
 	capitalHeight = surface.Ascent(font) - surface.InternalLeading(font);
 	aveCharWidth = surface.AverageCharWidth(font);
 	spaceWidth = surface.WidthText(font, " ", 1);
+	maxWidthASCII = 0;
+	for (char ch = ' '; ch <= '~'; ch++) {
+		maxWidthASCII = std::max(maxWidthASCII, surface.WidthText(font, &ch, 1));
+	}
 }
 
 ViewStyle::ViewStyle() : markers(MARKER_MAX + 1), indicators(INDIC_MAX + 1) {
@@ -229,6 +233,7 @@ void ViewStyle::Init(size_t stylesSize_) {
 	aveCharWidth = 8;
 	spaceWidth = 8;
 	tabWidth = spaceWidth * 8;
+	maxWidthASCII = 8;
 
 	selColours.fore = ColourOptional(ColourDesired(0xff, 0, 0));
 	selColours.back = ColourOptional(ColourDesired(0xc0, 0xc0, 0xc0), true);
@@ -363,6 +368,11 @@ void ViewStyle::Refresh(Surface &surface, int tabInChars) {
 	spaceWidth = styles[STYLE_DEFAULT].spaceWidth;
 	tabWidth = spaceWidth * tabInChars;
 
+	maxWidthASCII = 0;
+	for (FontMap::const_iterator it = fonts.cbegin(); it != fonts.cend(); ++it) {
+		maxWidthASCII = std::max(maxWidthASCII, it->second->maxWidthASCII);
+	}
+
 	controlCharWidth = 0.0;
 	if (controlCharSymbol >= 32) {
 		const char cc[2] = { static_cast<char>(controlCharSymbol), '\0' };
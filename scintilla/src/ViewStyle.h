@@ -109,6 +109,7 @@ public:
 	XYPOSITION aveCharWidth;
 	XYPOSITION spaceWidth;
 	XYPOSITION tabWidth;
+	XYPOSITION maxWidthASCII;
 	ForeBackColours selColours;
 	ColourDesired selAdditionalForeground;
 	ColourDesired selAdditionalBackground;
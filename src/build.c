@@ -739,6 +739,7 @@ static void build_spawn_cmd(GeanyDocument *doc, const gchar *cmd, const gchar *d
 
 	clear_all_errors();
 	SETPTR(current_dir_entered, NULL);
+	document_clear_real_path_cache();
 
 	utf8_working_dir = !EMPTY(dir) ? g_strdup(dir) : g_path_get_dirname(doc->file_name);
 	working_dir = utils_get_locale_from_utf8(utf8_working_dir);
@@ -441,8 +441,30 @@ void on_normal_size1_activate(GtkMenuItem *menuitem, gpointer user_data)
 }
 
 
-/* Changes window-title after switching tabs and lots of other things.
- * note: using 'after' makes Scintilla redraw before the UI, appearing more responsive */
+/* Changes window-title after switching tabs and lots of other things. */
+static void update_document_ui(GeanyDocument *doc)
+{
+	sidebar_select_openfiles_item(doc);
+	ui_save_buttons_toggle(doc->changed);
+	ui_set_window_title(doc);
+	ui_update_statusbar(doc, -1);
+	ui_update_popup_reundo_items(doc);
+	ui_document_show_hide(doc); /* update the document menu */
+	build_menu_update(doc);
+	sidebar_update_tag_list(doc, FALSE);
+	document_highlight_tags(doc);
+
+	document_check_disk_status(doc, TRUE);
+
+#ifdef HAVE_VTE
+	vte_cwd((doc->real_path != NULL) ? doc->real_path : doc->file_name, FALSE);
+#endif
+
+	g_signal_emit_by_name(geany_object, "document-activate", doc);
+}
+
+
+/* note: using 'after' makes Scintilla redraw before the UI, appearing more responsive */
 static void on_notebook1_switch_page_after(GtkNotebook *notebook, gpointer page,
 		guint page_num, gpointer user_data)
 {
@@ -454,25 +476,39 @@ static void on_notebook1_switch_page_after(GtkNotebook *notebook, gpointer page,
 	doc = document_get_from_notebook_child(page);
 
 	if (doc != NULL)
-	{
-		sidebar_select_openfiles_item(doc);
-		ui_save_buttons_toggle(doc->changed);
-		ui_set_window_title(doc);
-		ui_update_statusbar(doc, -1);
-		ui_update_popup_reundo_items(doc);
-		ui_document_show_hide(doc); /* update the document menu */
-		build_menu_update(doc);
-		sidebar_update_tag_list(doc, FALSE);
-		document_highlight_tags(doc);
+		update_document_ui(doc);
+}
 
-		document_check_disk_status(doc, TRUE);
 
-#ifdef HAVE_VTE
-		vte_cwd((doc->real_path != NULL) ? doc->real_path : doc->file_name, FALSE);
-#endif
+/* Unsets main_status.opening_session_files after opening files and switches to page_num,
+ * or the current page if negative, so that the page switch callbacks skipped while opening
+ * update the UI once for its document. */
+void callbacks_finish_opening_files(gint page_num)
+{
+	GtkNotebook *notebook = GTK_NOTEBOOK(main_widgets.notebook);
+	gint n_pages = gtk_notebook_get_n_pages(notebook);
+	gint cur_page = gtk_notebook_get_current_page(notebook);
+
+	if (page_num < 0)
+		page_num = cur_page;
+
+	/* if target page is current page, switch to another page first to really trigger an
+	 * event, while the callbacks are still skipped */
+	if (page_num == cur_page && n_pages > 1)
+		gtk_notebook_set_current_page(notebook, (cur_page + 1) % n_pages);
+
+	main_status.opening_session_files = FALSE;
+
+	if (page_num == cur_page && n_pages == 1)
+	{
+		/* there is no other page to switch from */
+		GeanyDocument *doc = document_get_from_page(page_num);
 
-		g_signal_emit_by_name(geany_object, "document-activate", doc);
+		if (doc != NULL)
+			update_document_ui(doc);
 	}
+	else if (n_pages > 0)
+		gtk_notebook_set_current_page(notebook, page_num);
 }
 
 
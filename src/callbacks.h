@@ -30,6 +30,8 @@ void callbacks_connect(GtkBuilder *builder);
 
 extern gboolean	ignore_callback;
 
+void callbacks_finish_opening_files(gint page_num);
+
 void on_new1_activate(GtkMenuItem *menuitem, gpointer user_data);
 
 void on_save1_activate(GtkMenuItem *menuitem, gpointer user_data);
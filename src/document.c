@@ -107,6 +107,10 @@ enum
 
 static guint doc_id_counter = 0;
 
+/* maximum number of entries in real_path_cache, a build usually only mentions a few files */
+#define REAL_PATH_CACHE_SIZE 64
+static GHashTable *real_path_cache = NULL;
+
 
 static void document_undo_clear_stack(GTrashStack **stack);
 static void document_undo_clear(GeanyDocument *doc);
@@ -169,6 +173,45 @@ static gchar *get_real_path_from_utf8(const gchar *utf8_filename)
 }
 
 
+/* Forgets the real paths looked up so far. Called when a build or Find in Files run starts, as
+ * files may have been moved or links changed since the last one, and when documents are
+ * opened, closed or renamed. */
+void document_clear_real_path_cache(void)
+{
+	if (real_path_cache)
+		g_hash_table_remove_all(real_path_cache);
+}
+
+
+/* Like get_real_path_from_utf8() but caches the result for absolute paths, so that looking up
+ * the same file repeatedly, e.g. for each line of build output, doesn't need a realpath()
+ * call each time. The cache only holds a few entries and is cleared whenever it is full. */
+static gchar *get_real_path_from_utf8_cached(const gchar *utf8_filename)
+{
+	const gchar *cached;
+	gchar *realname;
+
+	if (! g_path_is_absolute(utf8_filename))
+		return get_real_path_from_utf8(utf8_filename);
+
+	if (G_UNLIKELY(real_path_cache == NULL))
+		real_path_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+	cached = g_hash_table_lookup(real_path_cache, utf8_filename);
+	if (cached)
+		return g_strdup(cached);
+
+	realname = get_real_path_from_utf8(utf8_filename);
+	if (realname)
+	{
+		if (g_hash_table_size(real_path_cache) >= REAL_PATH_CACHE_SIZE)
+			g_hash_table_remove_all(real_path_cache);
+		g_hash_table_insert(real_path_cache, g_strdup(utf8_filename), g_strdup(realname));
+	}
+	return realname;
+}
+
+
 /**
  *  Finds a document with the given filename.
  *  This matches either an exact GeanyDocument::file_name string, or variant
@@ -204,7 +247,7 @@ GeanyDocument *document_find_by_filename(const gchar *utf8_filename)
 		}
 	}
 	/* Now try matching based on the realpath(), which is unique per file on disk */
-	realname = get_real_path_from_utf8(utf8_filename);
+	realname = get_real_path_from_utf8_cached(utf8_filename);
 	doc = document_find_by_real_path(realname);
 	g_free(realname);
 	return doc;
@@ -393,6 +436,12 @@ void document_finalize(void)
 	for (i = 0; i < documents_array->len; i++)
 		g_free(documents[i]);
 	g_ptr_array_free(documents_array, TRUE);
+
+	if (real_path_cache)
+	{
+		g_hash_table_destroy(real_path_cache);
+		real_path_cache = NULL;
+	}
 }
 
 
@@ -737,6 +786,7 @@ static gboolean remove_page(guint page_num)
 	g_free(doc->priv->saved_encoding.encoding);
 	g_free(doc->file_name);
 	g_free(doc->real_path);
+	document_clear_real_path_cache();
 	if (doc->tm_file)
 	{
 		tm_workspace_remove_source_file(doc->tm_file);
@@ -973,6 +1023,55 @@ static gboolean get_mtime(const gchar *locale_filename, time_t *time)
 }
 
 
+/* Like g_file_load_contents() but reads files of known size into a buffer allocated once with the
+ * right size. g_file_load_contents() grows its buffer while reading, which needs up to twice the
+ * file size and copies the data repeatedly, a problem with very large files. */
+static gboolean load_file_contents(GFile *file, gchar **contents, gsize *length, GError **error)
+{
+	GFileInputStream *stream;
+	GFileInfo *info;
+	goffset size = 0;
+	gboolean ret;
+
+	stream = g_file_read(file, NULL, error);
+	if (! stream)
+		return FALSE;
+
+	info = g_file_input_stream_query_info(stream, G_FILE_ATTRIBUTE_STANDARD_SIZE, NULL, NULL);
+	if (info)
+	{
+		size = g_file_info_get_size(info);
+		g_object_unref(info);
+	}
+
+	/* files in e.g. /proc/ report a size of 0, fall back to reading them in chunks */
+	if (size <= 0 || (guint64) size >= G_MAXSIZE)
+	{
+		g_object_unref(stream);
+		return g_file_load_contents(file, NULL, contents, length, NULL, error);
+	}
+
+	*contents = g_try_malloc((gsize) size + 1);
+	if (! *contents)
+	{
+		g_object_unref(stream);
+		g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NO_SPACE, g_strerror(ENOMEM));
+		return FALSE;
+	}
+
+	ret = g_input_stream_read_all(G_INPUT_STREAM(stream), *contents, (gsize) size, length, NULL, error);
+	g_object_unref(stream);
+	if (! ret)
+	{
+		g_free(*contents);
+		*contents = NULL;
+		return FALSE;
+	}
+	(*contents)[*length] = '\0';
+	return TRUE;
+}
+
+
 /* loads textfile data, verifies and converts to forced_enc or UTF-8. Also handles BOM. */
 static gboolean load_text_file(const gchar *locale_filename, const gchar *display_filename,
 	FileData *filedata, const gchar *forced_enc)
@@ -992,7 +1091,7 @@ static gboolean load_text_file(const gchar *locale_filename, const gchar *displa
 	{
 		GFile *file = g_file_new_for_path(locale_filename);
 
-		g_file_load_contents(file, NULL, &filedata->data, &filedata->len, NULL, &err);
+		load_file_contents(file, &filedata->data, &filedata->len, &err);
 		g_object_unref(file);
 	}
 	else
@@ -1349,6 +1448,7 @@ GeanyDocument *document_open_file_full(GeanyDocument *doc, const gchar *filename
 
 			/* file exists on disk, set real_path */
 			SETPTR(doc->real_path, utils_get_real_path(locale_filename));
+			document_clear_real_path_cache();
 
 			doc->priv->is_remote = utils_is_remote_path(locale_filename);
 			monitor_file_setup(doc);
@@ -1826,6 +1926,7 @@ gboolean document_save_file_as(GeanyDocument *doc, const gchar *utf8_fname)
 
 	/* reset real path, it's retrieved again in document_save() */
 	SETPTR(doc->real_path, NULL);
+	document_clear_real_path_cache();
 
 	/* detect filetype */
 	if (doc->file_type->id == GEANY_FILETYPES_NONE)
@@ -1865,19 +1966,21 @@ gboolean document_save_file_as(GeanyDocument *doc, const gchar *utf8_fname)
 }
 
 
-static gsize save_convert_to_encoding(GeanyDocument *doc, gchar **data, gsize *len)
+/* Converts @a len bytes of @a data from UTF-8 to the document's encoding.
+ * On success, the newly allocated result is returned in @a conv_data and @a conv_len. */
+static gboolean save_convert_to_encoding(GeanyDocument *doc, const gchar *data, gsize len,
+		gchar **conv_data, gsize *conv_len)
 {
 	GError *conv_error = NULL;
 	gchar* conv_file_contents = NULL;
 	gsize bytes_read;
-	gsize conv_len;
 
-	g_return_val_if_fail(data != NULL && *data != NULL, FALSE);
-	g_return_val_if_fail(len != NULL, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(conv_data != NULL && conv_len != NULL, FALSE);
 
 	/* try to convert it from UTF-8 to original encoding */
-	conv_file_contents = g_convert(*data, *len - 1, doc->encoding, "UTF-8",
-												&bytes_read, &conv_len, &conv_error);
+	conv_file_contents = g_convert(data, len, doc->encoding, "UTF-8",
+												&bytes_read, conv_len, &conv_error);
 
 	if (conv_error != NULL)
 	{
@@ -1892,7 +1995,7 @@ _("An error occurred while converting the file from UTF-8 in \"%s\". The file re
 			gint context_len;
 			gunichar unic;
 			/* don't read over the doc length */
-			gint max_len = MIN((gint)bytes_read + 6, (gint)*len - 1);
+			gint max_len = MIN((gint)bytes_read + 6, (gint)len);
 			gchar context[7]; /* read 6 bytes from Sci + '\0' */
 			sci_get_text_range(doc->editor->sci, bytes_read, max_len, context);
 
@@ -1917,11 +2020,8 @@ _("An error occurred while converting the file from UTF-8 in \"%s\". The file re
 		return FALSE;
 	}
 	else
-	{
-		g_free(*data);
-		*data = conv_file_contents;
-		*len = conv_len;
-	}
+		*conv_data = conv_file_contents;
+
 	return TRUE;
 }
 
@@ -2104,7 +2204,8 @@ GEANY_API_SYMBOL
 gboolean document_save_file(GeanyDocument *doc, gboolean force)
 {
 	gchar *errmsg;
-	gchar *data;
+	const gchar *data;
+	gchar *buffer = NULL;
 	gsize len;
 	gchar *locale_filename;
 	const GeanyFilePrefs *fp;
@@ -2147,33 +2248,39 @@ gboolean document_save_file(GeanyDocument *doc, gboolean force)
 	/* notify plugins which may wish to modify the document before it's saved */
 	g_signal_emit_by_name(geany_object, "document-before-save", doc);
 
-	len = sci_get_length(doc->editor->sci) + 1;
+	len = sci_get_length(doc->editor->sci);
 	if (doc->has_bom && encodings_is_unicode_charset(doc->encoding))
 	{	/* always write a UTF-8 BOM because in this moment the text itself is still in UTF-8
 		 * encoding, it will be converted to doc->encoding below and this conversion
 		 * also changes the BOM */
-		data = (gchar*) g_malloc(len + 3);	/* 3 chars for BOM */
-		data[0] = (gchar) 0xef;
-		data[1] = (gchar) 0xbb;
-		data[2] = (gchar) 0xbf;
-		sci_get_text(doc->editor->sci, len, data + 3);
+		buffer = (gchar*) g_malloc(len + 4);	/* 3 chars for BOM */
+		buffer[0] = (gchar) 0xef;
+		buffer[1] = (gchar) 0xbb;
+		buffer[2] = (gchar) 0xbf;
+		sci_get_text(doc->editor->sci, len + 1, buffer + 3);
 		len += 3;
+		data = buffer;
 	}
 	else
 	{
-		data = (gchar*) g_malloc(len);
-		sci_get_text(doc->editor->sci, len, data);
+		/* write directly from Scintilla's buffer instead of copying the whole text.
+		 * Warning: any SCI calls modifying the text will invalidate 'data' */
+		data = (const gchar *) SSM(doc->editor->sci, SCI_GETCHARACTERPOINTER, 0, 0);
 	}
 
 	/* save in original encoding, skip when it is already UTF-8 or has the encoding "None" */
 	if (doc->encoding != NULL && ! utils_str_equal(doc->encoding, "UTF-8") &&
 		! utils_str_equal(doc->encoding, encodings[GEANY_ENCODING_NONE].charset))
 	{
-		if (! save_convert_to_encoding(doc, &data, &len))
+		gchar *conv_data;
+
+		if (! save_convert_to_encoding(doc, data, len, &conv_data, &len))
 		{
-			g_free(data);
+			g_free(buffer);
 			return FALSE;
 		}
+		SETPTR(buffer, conv_data);
+		data = buffer;
 	}
 	else
 	{
@@ -2187,7 +2294,7 @@ gboolean document_save_file(GeanyDocument *doc, gboolean force)
 
 	/* actually write the content of data to the file on disk */
 	errmsg = save_doc(doc, locale_filename, data, len);
-	g_free(data);
+	g_free(buffer);
 
 	if (errmsg != NULL)
 	{
@@ -3674,6 +3781,7 @@ static void monitor_resave_missing_file(GeanyDocument *doc)
 		document_set_text_changed(doc, TRUE);
 		/* don't prompt more than once */
 		SETPTR(doc->real_path, NULL);
+		document_clear_real_path_cache();
 		doc->priv->info_bars[MSG_TYPE_RESAVE] = bar;
 		enable_key_intercept(doc, bar);
 	}
@@ -323,6 +323,8 @@ void document_set_data(GeanyDocument *doc, const gchar *key, gpointer data);
 void document_set_data_full(GeanyDocument *doc, const gchar *key,
 	gpointer data, GDestroyNotify free_func);
 
+void document_clear_real_path_cache(void);
+
 #endif /* GEANY_PRIVATE */
 
 G_END_DECLS
@@ -2882,9 +2882,13 @@ static gint find_in_current_style(ScintillaObject *sci, const gchar *text, gbool
 	gint start = sci_get_current_position(sci);
 	gint end = start;
 	gint len = sci_get_length(sci);
-	gint current_style = sci_get_style_at(sci, start);
+	gint current_style;
 	struct Sci_TextToFind ttf;
 
+	/* the style range may extend below the part styled so far */
+	sci_ensure_styled(sci, -1);
+	current_style = sci_get_style_at(sci, start);
+
 	while (start > 0 && sci_get_style_at(sci, start - 1) == current_style)
 		start -= 1;
 	while (end < len && sci_get_style_at(sci, end + 1) == current_style)
@@ -3010,6 +3014,9 @@ gint editor_do_uncomment(GeanyEditor *editor, gint line, gboolean toggle)
 		sel_start = sel_end = sci_get_position_from_line(editor->sci, line);
 	}
 
+	/* styles are checked up to the end of the last line */
+	sci_ensure_styled(editor->sci, sci_get_line_end_position(editor->sci, last_line));
+
 	ft = editor_get_filetype_at_line(editor, first_line);
 
 	if (! filetype_get_comment_open_close(ft, TRUE, &co, &cc))
@@ -3134,6 +3141,9 @@ void editor_do_comment_toggle(GeanyEditor *editor)
 	first_line_start = sci_get_position_from_line(editor->sci, first_line);
 	last_line_start = sci_get_position_from_line(editor->sci, last_line);
 
+	/* styles are checked up to the end of the last line */
+	sci_ensure_styled(editor->sci, sci_get_line_end_position(editor->sci, last_line));
+
 	ft = editor_get_filetype_at_line(editor, first_line);
 
 	if (! filetype_get_comment_open_close(ft, TRUE, &co, &cc))
@@ -3305,6 +3315,9 @@ gint editor_do_comment(GeanyEditor *editor, gint line, gboolean allow_empty_line
 		sel_start = sel_end = sci_get_position_from_line(editor->sci, line);
 	}
 
+	/* styles are checked up to the end of the last line */
+	sci_ensure_styled(editor->sci, sci_get_line_end_position(editor->sci, last_line));
+
 	ft = editor_get_filetype_at_line(editor, first_line);
 
 	if (! filetype_get_comment_open_close(ft, single_comment, &co, &cc))
@@ -4359,6 +4372,8 @@ static void fold_all(GeanyEditor *editor, gboolean want_fold)
 
 	lines = sci_get_line_count(editor->sci);
 	first = sci_get_first_visible_line(editor->sci);
+	/* fold points of the whole document are needed, so finish any pending idle styling */
+	sci_ensure_styled(editor->sci, -1);
 
 	for (i = 0; i < lines; i++)
 	{
@@ -4763,6 +4778,19 @@ on_editor_scroll_event(GtkWidget *widget, GdkEventScroll *event, gpointer user_d
 }
 
 
+/* Returns the end of the last line that is visible or holds the caret. */
+static gint get_visible_styling_end(ScintillaObject *sci)
+{
+	gint line = SSM(sci, SCI_DOCLINEFROMVISIBLE,
+		sci_get_first_visible_line(sci) + SSM(sci, SCI_LINESONSCREEN, 0, 0), 0);
+
+	line = MAX(line, sci_get_current_line(sci));
+	if (line + 1 >= sci_get_line_count(sci))
+		return -1;
+	return sci_get_position_from_line(sci, line + 1);
+}
+
+
 static gboolean editor_check_colourise(GeanyEditor *editor)
 {
 	GeanyDocument *doc = editor->document;
@@ -4771,10 +4799,12 @@ static gboolean editor_check_colourise(GeanyEditor *editor)
 		return FALSE;
 
 	doc->priv->colourise_needed = FALSE;
-	sci_colourise(editor->sci, 0, -1);
+	/* only lex up to the end of the view (or the caret line, if it is further down), the rest
+	 * of the document is styled by Scintilla in idle time, see SCI_SETIDLESTYLING */
+	sci_colourise(editor->sci, 0, get_visible_styling_end(editor->sci));
 
-	/* now that the current document is colourised, fold points are now accurate,
-	 * so force an update of the current function/tag. */
+	/* now that the document is colourised up to the current line, fold points are now
+	 * accurate, so force an update of the current function/tag. */
 	symbols_get_current_function(NULL, NULL);
 	ui_update_statusbar(NULL, -1);
 
@@ -4922,6 +4952,8 @@ static ScintillaObject *create_new_sci(GeanyEditor *editor)
 	/* Y policy is set in editor_apply_update_prefs() */
 	SSM(sci, SCI_AUTOCSETSEPARATOR, '\n', 0);
 	SSM(sci, SCI_SETSCROLLWIDTHTRACKING, 1, 0);
+	/* style text below the view in idle time instead of blocking on large documents */
+	SSM(sci, SCI_SETIDLESTYLING, SC_IDLESTYLING_AFTERVISIBLE, 0);
 
 	/* tag autocompletion images */
 	register_named_icon(sci, 1, "classviewer-var");
@@ -65,6 +65,7 @@ static gchar *filetypes_get_conf_extension(const GeanyFiletype *ft);
 static void read_filetype_config(void);
 static void create_set_filetype_menu(gboolean config);
 static gchar *filetypes_get_filename(GeanyFiletype *ft, gboolean user);
+static void pattern_matcher_invalidate(void);
 
 
 enum TitleType
@@ -250,6 +251,7 @@ static void filetype_add(GeanyFiletype *ft)
 	g_return_if_fail(ft);
 	g_return_if_fail(ft->name);
 
+	pattern_matcher_invalidate();
 	ft->id = filetypes_array->len;	/* len will be the index for filetype_array */
 	g_ptr_array_add(filetypes_array, ft);
 	g_hash_table_insert(filetypes_hash, ft->name, ft);
@@ -479,29 +481,129 @@ GeanyFiletype *filetypes_find(GCompareFunc predicate, gpointer user_data)
 }
 
 
-static gboolean match_basename(gconstpointer pft, gconstpointer user_data)
+/* All filetype patterns compiled together, so that matching a filename does not
+ * depend on the number of filetypes. Hash table values are filetype indexes + 1. */
+typedef struct
 {
-	const GeanyFiletype *ft = pft;
-	const gchar *base_filename = user_data;
-	gint j;
-	gboolean ret = FALSE;
+	guint			 ft_index;
+	GPatternSpec	*spec;
+}
+PatternGlob;
 
-	if (G_UNLIKELY(ft->id == GEANY_FILETYPES_NONE))
-		return FALSE;
+static struct
+{
+	gboolean	 valid;
+	GHashTable	*names;		/* patterns without wildcards, e.g. "Makefile" */
+	GHashTable	*suffixes;	/* the ".ext" part of "*.ext" patterns */
+	GPtrArray	*globs;		/* any other PatternGlob, in filetype order */
+}
+pattern_matcher = { FALSE, NULL, NULL, NULL };
+
+
+static void pattern_glob_free(gpointer data)
+{
+	PatternGlob *glob = data;
+
+	g_pattern_spec_free(glob->spec);
+	g_free(glob);
+}
+
+
+static void pattern_matcher_invalidate(void)
+{
+	if (!pattern_matcher.valid)
+		return;
+
+	g_hash_table_destroy(pattern_matcher.names);
+	g_hash_table_destroy(pattern_matcher.suffixes);
+	g_ptr_array_free(pattern_matcher.globs, TRUE);
+	pattern_matcher.valid = FALSE;
+}
+
+
+/* keeps the first (lowest) filetype index for a key, like searching filetypes in order */
+static void pattern_table_add(GHashTable *table, const gchar *key, guint ft_index)
+{
+	if (!g_hash_table_contains(table, key))
+		g_hash_table_insert(table, g_strdup(key), GUINT_TO_POINTER(ft_index + 1));
+}
+
+
+static void pattern_matcher_build(void)
+{
+	guint i;
 
-	for (j = 0; ft->pattern[j] != NULL; j++)
+	pattern_matcher.names = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	pattern_matcher.suffixes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	pattern_matcher.globs = g_ptr_array_new_with_free_func(pattern_glob_free);
+
+	for (i = 0; i < filetypes_array->len; i++)
 	{
-		GPatternSpec *pattern = g_pattern_spec_new(ft->pattern[j]);
+		GeanyFiletype *ft = filetypes[i];
+		gchar **pattern;
+
+		if (G_UNLIKELY(ft->id == GEANY_FILETYPES_NONE))
+			continue;
 
-		if (g_pattern_match_string(pattern, base_filename))
+		foreach_strv(pattern, ft->pattern)
 		{
-			ret = TRUE;
-			g_pattern_spec_free(pattern);
+			const gchar *pat = *pattern;
+
+			if (strpbrk(pat, "*?") == NULL)
+				pattern_table_add(pattern_matcher.names, pat, i);
+			else if (pat[0] == '*' && pat[1] == '.' && strpbrk(pat + 1, "*?") == NULL)
+				pattern_table_add(pattern_matcher.suffixes, pat + 1, i);
+			else
+			{
+				PatternGlob *glob = g_new(PatternGlob, 1);
+
+				glob->ft_index = i;
+				glob->spec = g_pattern_spec_new(pat);
+				g_ptr_array_add(pattern_matcher.globs, glob);
+			}
+		}
+	}
+	pattern_matcher.valid = TRUE;
+}
+
+
+/* Returns the first filetype with a pattern matching base_filename, or NULL. */
+static GeanyFiletype *pattern_matcher_find(const gchar *base_filename)
+{
+	guint best;
+	guint i;
+	gsize len;
+	const gchar *dot;
+
+	if (!pattern_matcher.valid)
+		pattern_matcher_build();
+
+	best = GPOINTER_TO_UINT(g_hash_table_lookup(pattern_matcher.names, base_filename));
+
+	/* "*.ext" matches any basename ending in ".ext", so try each suffix starting with a dot */
+	for (dot = strchr(base_filename, '.'); dot != NULL; dot = strchr(dot + 1, '.'))
+	{
+		guint idx = GPOINTER_TO_UINT(g_hash_table_lookup(pattern_matcher.suffixes, dot));
+
+		if (idx != 0 && (best == 0 || idx < best))
+			best = idx;
+	}
+
+	len = strlen(base_filename);
+	for (i = 0; i < pattern_matcher.globs->len; i++)
+	{
+		PatternGlob *glob = g_ptr_array_index(pattern_matcher.globs, i);
+
+		/* globs are in filetype order, so none of the remaining ones can win */
+		if (best != 0 && glob->ft_index + 1 >= best)
+			break;
+		if (g_pattern_match(glob->spec, len, base_filename, NULL))
+		{
+			best = glob->ft_index + 1;
 			break;
 		}
-		g_pattern_spec_free(pattern);
 	}
-	return ret;
+	return best != 0 ? filetypes[best - 1] : NULL;
 }
 
 
@@ -551,7 +653,7 @@ GeanyFiletype *filetypes_detect_from_extension(const gchar *utf8_filename)
 	SETPTR(base_filename, g_utf8_strdown(base_filename, -1));
 #endif
 
-	ft = filetypes_find(match_basename, base_filename);
+	ft = pattern_matcher_find(base_filename);
 	if (ft == NULL)
 		ft = filetypes[GEANY_FILETYPES_NONE];
 
@@ -673,6 +775,35 @@ static GeanyFiletype *find_shebang(const gchar *utf8_filename, const gchar *line
 }
 
 
+static GRegex *extract_filetype_regex = NULL;
+static gchar *extract_filetype_pattern = NULL;
+
+
+/* Returns the compiled file_prefs.extract_filetype_regex, only recompiling it when the
+ * preference has changed, or NULL if it is invalid. */
+static GRegex *get_extract_filetype_regex(void)
+{
+	GError *regex_error = NULL;
+
+	if (extract_filetype_pattern != NULL &&
+		g_strcmp0(extract_filetype_pattern, file_prefs.extract_filetype_regex) == 0)
+		return extract_filetype_regex;
+
+	if (extract_filetype_regex != NULL)
+		g_regex_unref(extract_filetype_regex);
+	SETPTR(extract_filetype_pattern, g_strdup(file_prefs.extract_filetype_regex));
+
+	extract_filetype_regex = g_regex_new(file_prefs.extract_filetype_regex,
+			G_REGEX_RAW | G_REGEX_MULTILINE, 0, &regex_error);
+	if (regex_error != NULL)
+	{
+		geany_debug("Filetype extract regex ignored: %s", regex_error->message);
+		g_error_free(regex_error);
+	}
+	return extract_filetype_regex;
+}
+
+
 /* Detect the filetype checking for a shebang, then filename extension.
  * @lines: an strv of the lines to scan (must containing at least one line) */
 static GeanyFiletype *filetypes_detect_from_file_internal(const gchar *utf8_filename,
@@ -682,7 +813,6 @@ static GeanyFiletype *filetypes_detect_from_file_internal(const gchar *utf8_file
 	gint			 i;
 	GRegex			*ft_regex;
 	GMatchInfo		*match;
-	GError			*regex_error = NULL;
 
 	/* try to find a shebang and if found use it prior to the filename extension
 	 * also checks for <?xml */
@@ -691,8 +821,7 @@ static GeanyFiletype *filetypes_detect_from_file_internal(const gchar *utf8_file
 		return ft;
 
 	/* try to extract the filetype using a regex capture */
-	ft_regex = g_regex_new(file_prefs.extract_filetype_regex,
-			G_REGEX_RAW | G_REGEX_MULTILINE, 0, &regex_error);
+	ft_regex = get_extract_filetype_regex();
 	if (ft_regex != NULL)
 	{
 		for (i = 0; ft == NULL && lines[i] != NULL; i++)
@@ -708,12 +837,6 @@ static GeanyFiletype *filetypes_detect_from_file_internal(const gchar *utf8_file
 			}
 			g_match_info_free(match);
 		}
-		g_regex_unref(ft_regex);
-	}
-	else if (regex_error != NULL)
-	{
-		geany_debug("Filetype extract regex ignored: %s", regex_error->message);
-		g_error_free(regex_error);
 	}
 	if (ft != NULL)
 		return ft;
@@ -862,6 +985,11 @@ void filetypes_free_types(void)
 	g_return_if_fail(filetypes_array != NULL);
 	g_return_if_fail(filetypes_hash != NULL);
 
+	pattern_matcher_invalidate();
+	if (extract_filetype_regex != NULL)
+		g_regex_unref(extract_filetype_regex);
+	extract_filetype_regex = NULL;
+	SETPTR(extract_filetype_pattern, NULL);
 	g_ptr_array_foreach(filetypes_array, filetype_free, NULL);
 	g_ptr_array_free(filetypes_array, TRUE);
 	g_hash_table_destroy(filetypes_hash);
@@ -1389,6 +1517,8 @@ static void read_extensions(GKeyFile *sysconfig, GKeyFile *userconfig)
 	guint i;
 	gsize len = 0;
 
+	pattern_matcher_invalidate();
+
 	/* read the keys */
 	for (i = 0; i < filetypes_array->len; i++)
 	{
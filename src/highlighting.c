@@ -64,6 +64,8 @@ typedef struct
 	gsize			count;		/* number of styles */
 	GeanyLexerStyle	*styling;		/* array of styles, NULL if not used or uninitialised */
 	gchar			**keywords;
+	gchar			**merged_keywords;	/* keywords with global typenames, see merge_type_keywords() */
+	guint			merged_typenames;	/* number of global typenames in merged_keywords */
 	gchar			*wordchars;	/* NULL used for style sets with no styles */
 	gchar			**property_keys;
 	gchar			**property_values;
@@ -149,6 +151,8 @@ static void free_styleset(guint file_type_id)
 	style_ptr->styling = NULL;
 	g_strfreev(style_ptr->keywords);
 	style_ptr->keywords = NULL;
+	g_strfreev(style_ptr->merged_keywords);
+	style_ptr->merged_keywords = NULL;
 	g_free(style_ptr->wordchars);
 	style_ptr->wordchars = NULL;
 	g_strfreev(style_ptr->property_keys);
@@ -407,14 +411,28 @@ static GeanyLexerStyle *get_style(guint ft_id, guint styling_index)
 }
 
 
+/* Sends a style setting message only if the value differs from the current one, as each
+ * SCI_STYLESET* message invalidates all of Scintilla's style and layout data. After
+ * SCI_STYLECLEARALL most styles already match the default one in most attributes. */
+static void set_sci_style_attribute(ScintillaObject *sci, guint get_msg, guint set_msg,
+		guint style, sptr_t value)
+{
+	if (SSM(sci, get_msg, style, 0) != value)
+		SSM(sci, set_msg, style, value);
+}
+
+
 static void set_sci_style(ScintillaObject *sci, guint style, guint ft_id, guint styling_index)
 {
 	GeanyLexerStyle *style_ptr = get_style(ft_id, styling_index);
 
-	SSM(sci, SCI_STYLESETFORE, style,	invert(style_ptr->foreground));
-	SSM(sci, SCI_STYLESETBACK, style,	invert(style_ptr->background));
-	SSM(sci, SCI_STYLESETBOLD, style,	style_ptr->bold);
-	SSM(sci, SCI_STYLESETITALIC, style,	style_ptr->italic);
+	set_sci_style_attribute(sci, SCI_STYLEGETFORE, SCI_STYLESETFORE, style,
+		invert(style_ptr->foreground));
+	set_sci_style_attribute(sci, SCI_STYLEGETBACK, SCI_STYLESETBACK, style,
+		invert(style_ptr->background));
+	set_sci_style_attribute(sci, SCI_STYLEGETBOLD, SCI_STYLESETBOLD, style, style_ptr->bold != 0);
+	set_sci_style_attribute(sci, SCI_STYLEGETITALIC, SCI_STYLESETITALIC, style,
+		style_ptr->italic != 0);
 }
 
 
@@ -806,22 +824,36 @@ static void styleset_common(ScintillaObject *sci, guint ft_id)
 
 
 /* Merge & assign global typedefs and user secondary keywords.
- * keyword_idx is used for both style_sets[].keywords and scintilla keyword style number */
+ * keyword_idx is used for both style_sets[].keywords and scintilla keyword style number.
+ * The merged words are kept for the next document of the filetype. */
 static void merge_type_keywords(ScintillaObject *sci, guint ft_id, guint keyword_idx)
 {
-	const gchar *user_words = style_sets[ft_id].keywords[keyword_idx];
-	GString *s;
+	StyleSet *set = &style_sets[ft_id];
+	GPtrArray *typenames = app->tm_workspace->global_typename_array;
+	guint n_typenames = typenames ? typenames->len : 0;
 
-	s = symbols_find_typenames_as_string(filetypes[ft_id]->lang, TRUE);
-	if (G_UNLIKELY(s == NULL))
-		s = g_string_sized_new(200);
-	else
-		g_string_append_c(s, ' '); /* append a space as delimiter to the existing list of words */
+	/* global tags are only ever added, so the typenames change only with their number */
+	if (set->merged_keywords == NULL || set->merged_typenames != n_typenames)
+	{
+		g_strfreev(set->merged_keywords);
+		set->merged_keywords = g_new0(gchar*, g_strv_length(set->keywords) + 1);
+		set->merged_typenames = n_typenames;
+	}
+	if (set->merged_keywords[keyword_idx] == NULL)
+	{
+		const gchar *user_words = set->keywords[keyword_idx];
+		GString *s;
 
-	g_string_append(s, user_words);
+		s = symbols_find_typenames_as_string(filetypes[ft_id]->lang, TRUE);
+		if (G_UNLIKELY(s == NULL))
+			s = g_string_sized_new(200);
+		else
+			g_string_append_c(s, ' '); /* append a space as delimiter to the existing list of words */
 
-	sci_set_keywords(sci, keyword_idx, s->str);
-	g_string_free(s, TRUE);
+		g_string_append(s, user_words);
+		set->merged_keywords[keyword_idx] = g_string_free(s, FALSE);
+	}
+	sci_set_keywords(sci, keyword_idx, set->merged_keywords[keyword_idx]);
 }
 
 
@@ -875,7 +907,8 @@ static void styleset_from_mapping(ScintillaObject *sci, guint ft_id, guint lexer
 		foreach_range(i, n_styles)
 		{
 			if (styles[i].fill_eol)
-				SSM(sci, SCI_STYLESETEOLFILLED, styles[i].style, TRUE);
+				set_sci_style_attribute(sci, SCI_STYLEGETEOLFILLED, SCI_STYLESETEOLFILLED,
+					styles[i].style, TRUE);
 			set_sci_style(sci, styles[i].style, ft_id, i);
 		}
 	}
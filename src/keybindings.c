@@ -71,6 +71,20 @@ static GeanyKeyBinding binding_ids[GEANY_KEYS_COUNT];
 static GtkAccelGroup *kb_accel_group = NULL;
 static const gboolean swap_alt_tab_order = FALSE;
 
+/* A keybinding with its group, as needed to run it */
+typedef struct
+{
+	GeanyKeyBinding *kb;
+	GeanyKeyGroup *group;
+}
+KeyBindingRef;
+
+/* maps key and modifiers to a GArray of KeyBindingRef in the order of keybinding_groups,
+ * so that key presses don't need to check every keybinding.
+ * Rebuilt on the next key press after keybindings have been changed. */
+static GHashTable *kb_index = NULL;
+static gboolean kb_index_dirty = TRUE;
+
 
 /* central keypress event handler, almost all keypress events go to this function */
 static gboolean on_key_press_event(GtkWidget *widget, GdkEventKey *event, gpointer user_data);
@@ -195,6 +209,7 @@ GeanyKeyBinding *keybindings_set_item(GeanyKeyGroup *group, gsize key_id,
 	}
 	kb->key = key;
 	kb->mods = mod;
+	kb_index_dirty = TRUE;
 	kb->default_key = key;
 	kb->default_mods = mod;
 	kb->callback = callback;
@@ -274,6 +289,7 @@ static void add_kb_group(GeanyKeyGroup *group,
 	group->plugin = plugin;
 	/* Only plugins use the destroy notify thus far */
 	group->key_items = g_ptr_array_new_with_free_func(plugin ? free_key_binding : NULL);
+	kb_index_dirty = TRUE;
 }
 
 
@@ -782,6 +798,7 @@ static void load_kb(GeanyKeyGroup *group, GeanyKeyBinding *kb, gpointer user_dat
 		gtk_accelerator_parse(val, &key, &mods);
 		kb->key = key;
 		kb->mods = mods;
+		kb_index_dirty = TRUE;
 		g_free(val);
 	}
 }
@@ -940,6 +957,9 @@ void keybindings_free(void)
 		keybindings_free_group(group);
 
 	g_ptr_array_free(keybinding_groups, TRUE);
+
+	if (kb_index)
+		g_hash_table_destroy(kb_index);
 }
 
 
@@ -1344,14 +1364,64 @@ static gboolean run_kb(GeanyKeyBinding *kb, GeanyKeyGroup *group)
 }
 
 
+static gint64 get_kb_index_key(guint key, guint mods)
+{
+	return ((gint64) mods << 32) | key;
+}
+
+
+static void free_kb_index_refs(gpointer data)
+{
+	g_array_free(data, TRUE);
+}
+
+
+static void update_kb_index(void)
+{
+	gsize g, i;
+	GeanyKeyGroup *group;
+	GeanyKeyBinding *kb;
+
+	if (G_LIKELY(! kb_index_dirty))
+		return;
+
+	if (kb_index == NULL)
+		kb_index = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, free_kb_index_refs);
+	else
+		g_hash_table_remove_all(kb_index);
+
+	foreach_ptr_array(group, g, keybinding_groups)
+	{
+		foreach_ptr_array(kb, i, group->key_items)
+		{
+			KeyBindingRef ref = { kb, group };
+			gint64 index_key;
+			GArray *refs;
+
+			if (kb->key == 0)
+				continue;
+
+			index_key = get_kb_index_key(kb->key, kb->mods);
+			refs = g_hash_table_lookup(kb_index, &index_key);
+			if (! refs)
+			{
+				refs = g_array_new(FALSE, FALSE, sizeof(KeyBindingRef));
+				g_hash_table_insert(kb_index, g_memdup(&index_key, sizeof index_key), refs);
+			}
+			g_array_append_val(refs, ref);
+		}
+	}
+	kb_index_dirty = FALSE;
+}
+
+
 /* central keypress event handler, almost all keypress events go to this function */
 static gboolean on_key_press_event(GtkWidget *widget, GdkEventKey *ev, gpointer user_data)
 {
 	guint state, keyval;
-	gsize g, i;
+	gint64 index_key;
+	GArray *refs;
 	GeanyDocument *doc;
-	GeanyKeyGroup *group;
-	GeanyKeyBinding *kb;
 	gboolean key_press_ret;
 
 	if (ev->keyval == 0)
@@ -1385,15 +1455,21 @@ static gboolean on_key_press_event(GtkWidget *widget, GdkEventKey *ev, gpointer
 	if (check_menu_key(doc, keyval, state, ev->time))
 		return TRUE;
 
-	foreach_ptr_array(group, g, keybinding_groups)
+	update_kb_index();
+	index_key = get_kb_index_key(keyval, state);
+	refs = g_hash_table_lookup(kb_index, &index_key);
+	if (refs)
 	{
-		foreach_ptr_array(kb, i, group->key_items)
+		guint i;
+
+		/* a keybinding callback might change keybindings, but the index is only rebuilt on
+		 * the next key press so refs stays valid */
+		for (i = 0; i < refs->len; i++)
 		{
-			if (keyval == kb->key && state == kb->mods)
-			{
-				if (run_kb(kb, group))
-					return TRUE;
-			}
+			KeyBindingRef *ref = &g_array_index(refs, KeyBindingRef, i);
+
+			if (run_kb(ref->kb, ref->group))
+				return TRUE;
 		}
 	}
 	/* fixed keybindings can be overridden by user bindings, so check them last */
@@ -2702,6 +2778,7 @@ void keybindings_update_combo(GeanyKeyBinding *kb, guint key, GdkModifierType mo
 
 	kb->key = key;
 	kb->mods = mods;
+	kb_index_dirty = TRUE;
 
 	if (widget && kb->key)
 		gtk_widget_add_accelerator(widget, "activate", kb_accel_group,
@@ -2727,6 +2804,7 @@ GeanyKeyGroup *keybindings_set_group(GeanyKeyGroup *group, const gchar *section_
 	/* Calls free_key_binding() for individual entries for plugins - has to be
 	 * called before g_free(group->plugin_keys) */
 	g_ptr_array_set_size(group->key_items, 0);
+	kb_index_dirty = TRUE;
 	g_free(group->plugin_keys);
 	group->plugin_keys = g_new0(GeanyKeyBinding, count);
 	group->plugin_key_count = count;
@@ -2737,4 +2815,5 @@ GeanyKeyGroup *keybindings_set_group(GeanyKeyGroup *group, const gchar *section_
 void keybindings_free_group(GeanyKeyGroup *group)
 {
 	g_ptr_array_remove_fast(keybinding_groups, group);
+	kb_index_dirty = TRUE;
 }
@@ -35,6 +35,7 @@
 
 #include "app.h"
 #include "build.h"
+#include "callbacks.h"
 #include "document.h"
 #include "encodings.h"
 #include "encodingsprivate.h"
@@ -1261,16 +1262,7 @@ void configuration_open_files(void)
 	{
 		/* explicitly trigger a notebook page switch after unsetting main_status.opening_session_files
 		 * for callbacks to run (and update window title, encoding settings, and so on) */
-		gint n_pages = gtk_notebook_get_n_pages(GTK_NOTEBOOK(main_widgets.notebook));
-		gint cur_page = gtk_notebook_get_current_page(GTK_NOTEBOOK(main_widgets.notebook));
-		gint target_page = session_notebook_page >= 0 ? session_notebook_page : cur_page;
-
-		/* if target page is current page, switch to another page first to really trigger an event */
-		if (target_page == cur_page && n_pages > 0)
-			gtk_notebook_set_current_page(GTK_NOTEBOOK(main_widgets.notebook), (cur_page + 1) % n_pages);
-
-		main_status.opening_session_files = FALSE;
-		gtk_notebook_set_current_page(GTK_NOTEBOOK(main_widgets.notebook), target_page);
+		callbacks_finish_opening_files(session_notebook_page);
 	}
 	main_status.opening_session_files = FALSE;
 }
@@ -397,6 +397,29 @@ void msgwin_show_hide(gboolean show)
 }
 
 
+/* Returns a newly allocated, valid UTF-8 copy of @a string suitable for the messages tab. */
+static gchar *get_msg_string(const gchar *string)
+{
+	gchar *tmp;
+	gchar *utf8_msg;
+
+	/* work around a strange problem when adding very long lines(greater than 4000 bytes)
+	 * cut the string to a maximum of 1024 bytes and discard the rest */
+	/* TODO: find the real cause for the display problem / if it is GtkTreeView file a bug report */
+	if (strlen(string) > 1024)
+		tmp = g_strndup(string, 1024);
+	else
+		tmp = g_strdup(string);
+
+	if (g_utf8_validate(tmp, -1, NULL))
+		return tmp;
+
+	utf8_msg = utils_get_utf8_from_locale(tmp);
+	g_free(tmp);
+	return utf8_msg;
+}
+
+
 /**
  * Adds a formatted message in the messages tab treeview in the messages window.
  *
@@ -446,37 +469,40 @@ void msgwin_msg_add(gint msg_color, gint line, GeanyDocument *doc, const gchar *
 GEANY_API_SYMBOL
 void msgwin_msg_add_string(gint msg_color, gint line, GeanyDocument *doc, const gchar *string)
 {
-	GtkTreeIter iter;
-	const GdkColor *color = get_color(msg_color);
-	gchar *tmp;
-	gsize len;
 	gchar *utf8_msg;
 
 	if (! ui_prefs.msgwindow_visible)
 		msgwin_show_hide(TRUE);
 
-	/* work around a strange problem when adding very long lines(greater than 4000 bytes)
-	 * cut the string to a maximum of 1024 bytes and discard the rest */
-	/* TODO: find the real cause for the display problem / if it is GtkTreeView file a bug report */
-	len = strlen(string);
-	if (len > 1024)
-		tmp = g_strndup(string, 1024);
-	else
-		tmp = g_strdup(string);
+	utf8_msg = get_msg_string(string);
+	gtk_list_store_insert_with_values(msgwindow.store_msg, NULL, -1,
+		MSG_COL_LINE, line, MSG_COL_DOC_ID, doc ? doc->id : 0, MSG_COL_COLOR,
+		get_color(msg_color), MSG_COL_STRING, utf8_msg, -1);
+	g_free(utf8_msg);
+}
 
-	if (! g_utf8_validate(tmp, -1, NULL))
-		utf8_msg = utils_get_utf8_from_locale(tmp);
-	else
-		utf8_msg = tmp;
 
-	gtk_list_store_append(msgwindow.store_msg, &iter);
-	gtk_list_store_set(msgwindow.store_msg, &iter,
-		MSG_COL_LINE, line, MSG_COL_DOC_ID, doc ? doc->id : 0, MSG_COL_COLOR,
-		color, MSG_COL_STRING, utf8_msg, -1);
+/* Adds @a n_strings messages without a document in one pass, e.g. for the output
+ * of a running search. */
+void msgwin_msg_add_strings(gint msg_color, const gchar **strings, guint n_strings)
+{
+	const GdkColor *color = get_color(msg_color);
+	guint i;
 
-	g_free(tmp);
-	if (utf8_msg != tmp)
+	if (n_strings == 0)
+		return;
+	if (! ui_prefs.msgwindow_visible)
+		msgwin_show_hide(TRUE);
+
+	for (i = 0; i < n_strings; i++)
+	{
+		gchar *utf8_msg = get_msg_string(strings[i]);
+
+		gtk_list_store_insert_with_values(msgwindow.store_msg, NULL, -1,
+			MSG_COL_LINE, -1, MSG_COL_DOC_ID, 0, MSG_COL_COLOR, color,
+			MSG_COL_STRING, utf8_msg, -1);
 		g_free(utf8_msg);
+	}
 }
 
 
@@ -95,6 +95,8 @@ void msgwin_finalize(void);
 
 void msgwin_show_hide(gboolean show);
 
+void msgwin_msg_add_strings(gint msg_color, const gchar **strings, guint n_strings);
+
 void msgwin_show_hide_tabs(void);
 
 
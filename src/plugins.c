@@ -1100,6 +1100,21 @@ static PluginProxy* is_plugin(const gchar *file)
 }
 
 
+/* Loads an active plugin at startup.
+ * Returns: FALSE if the plugin exists but could not be loaded. */
+static gboolean load_active_plugin(const gchar *fname)
+{
+	PluginProxy *proxy = NULL;
+
+	if (EMPTY(fname) || ! g_file_test(fname, G_FILE_TEST_EXISTS))
+		return TRUE;
+
+	if (check_plugin_path(fname))
+		proxy = is_plugin(fname);
+	return proxy != NULL && plugin_new(proxy->plugin, fname, TRUE, FALSE) != NULL;
+}
+
+
 /* load active plugins at startup */
 static void
 load_active_plugins(void)
@@ -1109,33 +1124,39 @@ load_active_plugins(void)
 	if (active_plugins_pref == NULL || (len = g_strv_length(active_plugins_pref)) == 0)
 		return;
 
-	/* If proxys are loaded we have to restart to load plugins that sort before their proxy */
-	do
+	g_list_free_full(failed_plugins_list, (GDestroyNotify) g_free);
+	failed_plugins_list = NULL;
+	proxies = active_proxies.length;
+	for (i = 0; i < len; i++)
 	{
-		proxies = active_proxies.length;
-		g_list_free_full(failed_plugins_list, (GDestroyNotify) g_free);
-		failed_plugins_list = NULL;
-		for (i = 0; i < len; i++)
-		{
-			gchar *fname = active_plugins_pref[i];
+		gchar *fname = active_plugins_pref[i];
 
 #ifdef G_OS_WIN32
-			/* ensure we have canonical paths */
-			gchar *p = fname;
-			while ((p = strchr(p, '/')) != NULL)
-				*p = G_DIR_SEPARATOR;
+		/* ensure we have canonical paths */
+		gchar *p = fname;
+		while ((p = strchr(p, '/')) != NULL)
+			*p = G_DIR_SEPARATOR;
 #endif
 
-			if (!EMPTY(fname) && g_file_test(fname, G_FILE_TEST_EXISTS))
-			{
-				PluginProxy *proxy = NULL;
-				if (check_plugin_path(fname))
-					proxy = is_plugin(fname);
-				if (proxy == NULL || plugin_new(proxy->plugin, fname, TRUE, FALSE) == NULL)
-					failed_plugins_list = g_list_prepend(failed_plugins_list, g_strdup(fname));
-			}
+		if (! load_active_plugin(fname))
+			failed_plugins_list = g_list_prepend(failed_plugins_list, g_strdup(fname));
+	}
+
+	/* If proxys were loaded, plugins that sort before their proxy failed to load, so retry
+	 * only those (until no more proxies get loaded) */
+	while (failed_plugins_list != NULL && proxies != active_proxies.length)
+	{
+		GList *node, *failed = g_list_reverse(failed_plugins_list);
+
+		proxies = active_proxies.length;
+		failed_plugins_list = NULL;
+		foreach_list(node, failed)
+		{
+			if (! load_active_plugin(node->data))
+				failed_plugins_list = g_list_prepend(failed_plugins_list, g_strdup(node->data));
 		}
-	} while (proxies != active_proxies.length);
+		g_list_free_full(failed, (GDestroyNotify) g_free);
+	}
 }
 
 
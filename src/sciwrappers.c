@@ -792,6 +792,24 @@ void sci_colourise(ScintillaObject *sci, gint start, gint end)
 }
 
 
+/* Makes sure the text up to @a end (-1 for the whole document) is styled, because text
+ * below the view is only styled in idle time, see SCI_SETIDLESTYLING. */
+void sci_ensure_styled(ScintillaObject *sci, gint end)
+{
+	gint end_styled = sci_get_end_styled(sci);
+
+	if (end < 0)
+		end = sci_get_length(sci);
+	if (end > end_styled)
+	{
+		/* lexers restart from the beginning of a line */
+		gint start = sci_get_position_from_line(sci, sci_get_line_from_position(sci, end_styled));
+
+		sci_colourise(sci, start, end);
+	}
+}
+
+
 void sci_clear_all(ScintillaObject *sci)
 {
 	SSM(sci, SCI_CLEARALL, 0, 0);
@@ -161,6 +161,7 @@ void 				sci_set_folding_margin_visible (ScintillaObject *sci, gboolean set);
 gboolean			sci_get_fold_expanded		(ScintillaObject *sci, gint line);
 
 void				sci_colourise				(ScintillaObject *sci, gint start, gint end);
+void				sci_ensure_styled			(ScintillaObject *sci, gint end);
 void				sci_clear_all				(ScintillaObject *sci);
 gint				sci_get_end_styled			(ScintillaObject *sci);
 void				sci_set_tab_width			(ScintillaObject *sci, gint width);
@@ -86,6 +86,7 @@ static struct
 	gboolean fif_match_whole_word;
 	gboolean fif_invert_results;
 	gboolean fif_recursive;
+	gboolean fif_skip_vcs_dirs;
 	gboolean fif_use_extra_options;
 	gchar *fif_extra_options;
 	gint fif_files_mode;
@@ -146,12 +147,30 @@ static struct
 }
 fif_dlg = {NULL, NULL, NULL, NULL, NULL, NULL, {0, 0}};
 
+/* Find in Files output lines waiting to be added to the messages window */
+typedef struct
+{
+	gint color;
+	gchar *text;
+}
+FifMessage;
+
+/* flush at least this often while grep is running (in ms) */
+#define FIF_FLUSH_INTERVAL 100
+/* flush immediately once this many lines are pending */
+#define FIF_FLUSH_MAX_LINES 1000
+
+static GArray *fif_pending = NULL;
+static guint fif_flush_source_id = 0;
+
 
 static void search_read_io(GString *string, GIOCondition condition, gpointer data);
 static void search_read_io_stderr(GString *string, GIOCondition condition, gpointer data);
 
 static void search_finished(GPid child_pid, gint status, gpointer user_data);
 
+static void fif_discard_messages(void);
+
 static gchar **search_get_argv(const gchar **argv_prefix, const gchar *dir);
 
 static GRegex *compile_regex(const gchar *str, GeanyFindFlags sflags);
@@ -223,6 +242,8 @@ static void init_prefs(void)
 		"fif_invert_results", FALSE, "check_invert");
 	stash_group_add_toggle_button(group, &settings.fif_recursive,
 		"fif_recursive", FALSE, "check_recursive");
+	stash_group_add_toggle_button(group, &settings.fif_skip_vcs_dirs,
+		"fif_skip_vcs_dirs", FALSE, "check_skip_vcs");
 	stash_group_add_entry(group, &settings.fif_extra_options,
 		"fif_extra_options", "", "entry_extra");
 	stash_group_add_toggle_button(group, &settings.fif_use_extra_options,
@@ -288,6 +309,9 @@ void search_finalize(void)
 	FREE_WIDGET(find_dlg.dialog);
 	FREE_WIDGET(replace_dlg.dialog);
 	FREE_WIDGET(fif_dlg.dialog);
+	fif_discard_messages();
+	if (fif_pending != NULL)
+		g_array_free(fif_pending, TRUE);
 	g_free(search_data.text);
 	g_free(search_data.original_text);
 }
@@ -860,7 +884,8 @@ static void create_fif_dialog(void)
 {
 	GtkWidget *dir_combo, *combo, *fcombo, *e_combo, *entry;
 	GtkWidget *label, *label1, *label2, *label3, *checkbox1, *checkbox2, *check_wholeword,
-		*check_recursive, *check_extra, *entry_extra, *check_regexp, *combo_files_mode;
+		*check_recursive, *check_skip_vcs, *check_extra, *entry_extra, *check_regexp,
+		*combo_files_mode;
 	GtkWidget *dbox, *sbox, *lbox, *rbox, *hbox, *vbox, *ebox;
 	GtkSizeGroup *size_group;
 
@@ -967,6 +992,17 @@ static void create_fif_dialog(void)
 	ui_hookup_widget(fif_dlg.dialog, check_recursive, "check_recursive");
 	gtk_button_set_focus_on_click(GTK_BUTTON(check_recursive), FALSE);
 
+	check_skip_vcs = gtk_check_button_new_with_mnemonic(_("Skip _version control folders"));
+	ui_hookup_widget(fif_dlg.dialog, check_skip_vcs, "check_skip_vcs");
+	gtk_button_set_focus_on_click(GTK_BUTTON(check_skip_vcs), FALSE);
+	gtk_widget_set_sensitive(check_skip_vcs, FALSE);
+	gtk_widget_set_tooltip_text(check_skip_vcs,
+			_("Do not descend into folders like .git or .svn when recursing"));
+
+	/* enable check_skip_vcs when check_recursive is checked */
+	g_signal_connect(check_recursive, "toggled",
+		G_CALLBACK(on_widget_toggled_set_sensitive), check_skip_vcs);
+
 	checkbox1 = gtk_check_button_new_with_mnemonic(_("C_ase sensitive"));
 	ui_hookup_widget(fif_dlg.dialog, checkbox1, "check_case");
 	gtk_button_set_focus_on_click(GTK_BUTTON(checkbox1), FALSE);
@@ -990,7 +1026,7 @@ static void create_fif_dialog(void)
 	rbox = gtk_vbox_new(FALSE, 0);
 	gtk_container_add(GTK_CONTAINER(rbox), checkbox1);
 	gtk_container_add(GTK_CONTAINER(rbox), check_wholeword);
-	gtk_container_add(GTK_CONTAINER(rbox), gtk_label_new(NULL));
+	gtk_container_add(GTK_CONTAINER(rbox), check_skip_vcs);
 
 	hbox = gtk_hbox_new(FALSE, 6);
 	gtk_container_add(GTK_CONTAINER(hbox), lbox);
@@ -1565,6 +1601,16 @@ static GString *get_grep_options(void)
 	else
 		g_string_append_c(gstr, 'E');
 
+	if (settings.fif_recursive && settings.fif_skip_vcs_dirs)
+	{
+		/* version control metadata can be much larger than the working tree itself */
+		static const gchar *vcs_dirs[] = { ".bzr", ".git", ".hg", ".svn", "_darcs", "CVS" };
+		guint i;
+
+		for (i = 0; i < G_N_ELEMENTS(vcs_dirs); i++)
+			g_string_append_printf(gstr, " --exclude-dir=%s", vcs_dirs[i]);
+	}
+
 	if (settings.fif_use_extra_options)
 	{
 		g_strstrip(settings.fif_extra_options);
@@ -1694,6 +1740,8 @@ search_find_in_files(const gchar *utf8_search_text, const gchar *utf8_dir, const
 		}
 	}
 
+	fif_discard_messages();
+	document_clear_real_path_cache();
 	gtk_list_store_clear(msgwindow.store_msg);
 	gtk_notebook_set_current_page(GTK_NOTEBOOK(msgwindow.notebook), MSG_MESSAGE);
 
@@ -1803,6 +1851,88 @@ static gchar **search_get_argv(const gchar **argv_prefix, const gchar *dir)
 }
 
 
+static void fif_flush_messages(void)
+{
+	const gchar **strings;
+	guint i;
+
+	if (fif_flush_source_id != 0)
+	{
+		g_source_remove(fif_flush_source_id);
+		fif_flush_source_id = 0;
+	}
+	if (fif_pending == NULL)
+		return;
+
+	/* add each run of lines with the same color in one go */
+	strings = g_new(const gchar *, fif_pending->len);
+	for (i = 0; i < fif_pending->len; )
+	{
+		FifMessage *first = &g_array_index(fif_pending, FifMessage, i);
+		guint n = 0;
+
+		for (; i < fif_pending->len; i++, n++)
+		{
+			FifMessage *fm = &g_array_index(fif_pending, FifMessage, i);
+
+			if (fm->color != first->color)
+				break;
+			strings[n] = fm->text;
+		}
+		msgwin_msg_add_strings(first->color, strings, n);
+	}
+	g_free(strings);
+	for (i = 0; i < fif_pending->len; i++)
+		g_free(g_array_index(fif_pending, FifMessage, i).text);
+	g_array_set_size(fif_pending, 0);
+}
+
+
+static void fif_discard_messages(void)
+{
+	guint i;
+
+	if (fif_flush_source_id != 0)
+	{
+		g_source_remove(fif_flush_source_id);
+		fif_flush_source_id = 0;
+	}
+	if (fif_pending == NULL)
+		return;
+
+	for (i = 0; i < fif_pending->len; i++)
+		g_free(g_array_index(fif_pending, FifMessage, i).text);
+	g_array_set_size(fif_pending, 0);
+}
+
+
+static gboolean fif_flush_timeout(G_GNUC_UNUSED gpointer data)
+{
+	fif_flush_source_id = 0;
+	fif_flush_messages();
+	return FALSE;
+}
+
+
+/* Queues a line of grep output, taking ownership of @a text. Lines are added to the
+ * messages window in batches rather than one by one, as searches in big trees can
+ * produce a lot of output. */
+static void fif_queue_message(gint msg_color, gchar *text)
+{
+	FifMessage fm = { msg_color, text };
+
+	if (fif_pending == NULL)
+		fif_pending = g_array_new(FALSE, FALSE, sizeof(FifMessage));
+
+	g_array_append_val(fif_pending, fm);
+
+	if (fif_pending->len >= FIF_FLUSH_MAX_LINES)
+		fif_flush_messages();
+	else if (fif_flush_source_id == 0)
+		fif_flush_source_id = g_timeout_add(FIF_FLUSH_INTERVAL, fif_flush_timeout, NULL);
+}
+
+
 static void read_fif_io(gchar *msg, GIOCondition condition, gchar *enc, gint msg_color)
 {
 	if (condition & (G_IO_IN | G_IO_PRI))
@@ -1811,22 +1941,12 @@ static void read_fif_io(gchar *msg, GIOCondition condition, gchar *enc, gint msg
 
 		g_strstrip(msg);
 		/* enc is NULL when encoding is set to UTF-8, so we can skip any conversion */
-		if (enc != NULL)
-		{
-			if (! g_utf8_validate(msg, -1, NULL))
-			{
-				utf8_msg = g_convert(msg, -1, "UTF-8", enc, NULL, NULL, NULL);
-			}
-			if (utf8_msg == NULL)
-				utf8_msg = msg;
-		}
-		else
-			utf8_msg = msg;
+		if (enc != NULL && ! g_utf8_validate(msg, -1, NULL))
+			utf8_msg = g_convert(msg, -1, "UTF-8", enc, NULL, NULL, NULL);
+		if (utf8_msg == NULL)
+			utf8_msg = g_strdup(msg);
 
-		msgwin_msg_add_string(msg_color, -1, NULL, utf8_msg);
-
-		if (utf8_msg != msg)
-			g_free(utf8_msg);
+		fif_queue_message(msg_color, utf8_msg);
 	}
 }
 
@@ -1848,6 +1968,8 @@ static void search_finished(GPid child_pid, gint status, gpointer user_data)
 	const gchar *msg = _("Search failed.");
 	gint exit_status;
 
+	fif_flush_messages();
+
 	if (SPAWN_WIFEXITED(status))
 	{
 		exit_status = SPAWN_WEXITSTATUS(status);
@@ -1923,6 +2045,18 @@ static gchar *get_regex_match_string(const gchar *text, const GeanyMatchInfo *ma
 }
 
 
+/* Whether @a regex may look at text before the line it matches on, i.e. it uses a lookbehind
+ * assertion or \A, so it has to be matched against the whole document. This may give false
+ * positives (e.g. for an escaped backslash followed by "A"), which only cost speed. */
+static gboolean regex_looks_behind(GRegex *regex)
+{
+	const gchar *pattern = g_regex_get_pattern(regex);
+
+	return strstr(pattern, "(?<=") != NULL || strstr(pattern, "(?<!") != NULL ||
+		strstr(pattern, "\\A") != NULL;
+}
+
+
 static gint find_regex(ScintillaObject *sci, guint pos, GRegex *regex, gboolean multiline, GeanyMatchInfo *match)
 {
 	const gchar *text;
@@ -1937,7 +2071,20 @@ static gint find_regex(ScintillaObject *sci, guint pos, GRegex *regex, gboolean
 
 	g_return_val_if_fail(pos <= document_length, -1);
 
-	if (multiline)
+	if (multiline && ! regex_looks_behind(regex))
+	{
+		gint start = sci_get_position_from_line(sci, sci_get_line_from_position(sci, pos));
+
+		/* Only ask for the text from the start of the line, so that Scintilla only has to move
+		 * its gap up to there instead of to the end of the document (as SCI_GETCHARACTERPOINTER
+		 * does). This matters when replacing many matches in a large document, where the gap
+		 * is right behind the previous replacement.
+		 * Warning: any SCI calls will invalidate 'text' after calling SCI_GETRANGEPOINTER */
+		text = (void*)SSM(sci, SCI_GETRANGEPOINTER, start, document_length - start);
+		g_regex_match_full(regex, text, document_length - start, pos - start, 0, &minfo, NULL);
+		offset = start;
+	}
+	else if (multiline)
 	{
 		/* Warning: any SCI calls will invalidate 'text' after calling SCI_GETCHARACTERPOINTER */
 		text = (void*)SSM(sci, SCI_GETCHARACTERPOINTER, 0, 0);
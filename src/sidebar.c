@@ -34,6 +34,7 @@
 #include "filetypesprivate.h"
 #include "geanyobject.h"
 #include "keyfile.h"
+#include "main.h"
 #include "navqueue.h"
 #include "stash.h"
 #include "support.h"
@@ -87,6 +88,8 @@ enum
 };
 
 static GtkTreeStore	*store_openfiles;
+static GHashTable	*openfiles_dirs;	/* folder rows (GtkTreeIter*) by their shown name */
+static guint openfiles_sort_idle_id = 0;
 static GtkWidget *openfiles_popup_menu;
 static gboolean documents_show_paths;
 static GtkWidget *tag_window;	/* scrolled window that holds the symbol list GtkTreeView */
@@ -316,6 +319,8 @@ static void prepare_openfiles(void)
 	gtk_tree_sortable_set_sort_func(sortable, DOCUMENTS_SHORTNAME, documents_sort_func, NULL, NULL);
 	gtk_tree_sortable_set_sort_column_id(sortable, DOCUMENTS_SHORTNAME, GTK_SORT_ASCENDING);
 
+	openfiles_dirs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
 	ui_widget_modify_font_from_string(tv.tree_openfiles, interface_prefs.tagbar_font);
 
 	/* tooltips */
@@ -333,25 +338,50 @@ static void prepare_openfiles(void)
 }
 
 
-/* iter should be toplevel */
-static gboolean find_tree_iter_dir(GtkTreeIter *iter, const gchar *dir)
+/* returns the openfiles_dirs key for a folder row name */
+static gchar *get_dir_key(const gchar *dir)
 {
-	GeanyDocument *doc;
-	gchar *name;
-	gboolean result;
+#ifdef G_OS_WIN32
+	/* like utils_filenamecmp() */
+	return g_utf8_casefold(dir, -1);
+#else
+	return g_strdup(dir);
+#endif
+}
 
-	if (utils_str_equal(dir, "."))
-		dir = GEANY_STRING_UNTITLED;
 
-	gtk_tree_model_get(GTK_TREE_MODEL(store_openfiles), iter, DOCUMENTS_DOCUMENT, &doc, -1);
-	g_return_val_if_fail(!doc, FALSE);
+static void openfiles_resume_sorting(void)
+{
+	if (openfiles_sort_idle_id != 0)
+	{
+		g_source_remove(openfiles_sort_idle_id);
+		openfiles_sort_idle_id = 0;
+		gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store_openfiles),
+			DOCUMENTS_SHORTNAME, GTK_SORT_ASCENDING);
+	}
+}
+
 
-	gtk_tree_model_get(GTK_TREE_MODEL(store_openfiles), iter, DOCUMENTS_SHORTNAME, &name, -1);
+static gboolean openfiles_resume_sorting_idle(gpointer data)
+{
+	openfiles_sort_idle_id = 0;
+	gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store_openfiles),
+		DOCUMENTS_SHORTNAME, GTK_SORT_ASCENDING);
+	return FALSE;
+}
 
-	result = utils_filenamecmp(name, dir) == 0;
-	g_free(name);
 
-	return result;
+/* Each row added to the sorted store is moved into place by walking its siblings, so
+ * when adding many rows at once sort them only once, when idle or on
+ * openfiles_resume_sorting(). */
+static void openfiles_suspend_sorting(void)
+{
+	if (openfiles_sort_idle_id == 0)
+	{
+		gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store_openfiles),
+			GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, GTK_SORT_ASCENDING);
+		openfiles_sort_idle_id = g_idle_add(openfiles_resume_sorting_idle, NULL);
+	}
 }
 
 
@@ -421,8 +451,10 @@ static GtkTreeIter *get_doc_parent(GeanyDocument *doc)
 {
 	gchar *path;
 	gchar *dirname = NULL;
+	const gchar *shortname;
+	gchar *key;
+	GtkTreeIter *dir_iter;
 	static GtkTreeIter parent;
-	GtkTreeModel *model = GTK_TREE_MODEL(store_openfiles);
 	static GIcon *dir_icon = NULL;
 
 	if (!documents_show_paths)
@@ -430,19 +462,17 @@ static GtkTreeIter *get_doc_parent(GeanyDocument *doc)
 
 	path = g_path_get_dirname(DOC_FILENAME(doc));
 	dirname = get_doc_folder(path);
+	shortname = doc->file_name ? dirname : GEANY_STRING_UNTITLED;
+	key = get_dir_key(shortname);
 
-	if (gtk_tree_model_get_iter_first(model, &parent))
+	dir_iter = g_hash_table_lookup(openfiles_dirs, key);
+	if (dir_iter)
 	{
-		do
-		{
-			if (find_tree_iter_dir(&parent, dirname))
-			{
-				g_free(dirname);
-				g_free(path);
-				return &parent;
-			}
-		}
-		while (gtk_tree_model_iter_next(model, &parent));
+		parent = *dir_iter;
+		g_free(key);
+		g_free(dirname);
+		g_free(path);
+		return &parent;
 	}
 	/* no match, add dir parent */
 	if (!dir_icon)
@@ -451,7 +481,12 @@ static GtkTreeIter *get_doc_parent(GeanyDocument *doc)
 	gtk_tree_store_append(store_openfiles, &parent, NULL);
 	gtk_tree_store_set(store_openfiles, &parent, DOCUMENTS_ICON, dir_icon,
 		DOCUMENTS_FILENAME, path,
-		DOCUMENTS_SHORTNAME, doc->file_name ? dirname : GEANY_STRING_UNTITLED, -1);
+		DOCUMENTS_SHORTNAME, shortname, -1);
+
+	/* the store's iters persist until their row is removed */
+	dir_iter = g_new(GtkTreeIter, 1);
+	*dir_iter = parent;
+	g_hash_table_insert(openfiles_dirs, key, dir_iter);
 
 	g_free(dirname);
 	g_free(path);
@@ -469,6 +504,9 @@ void sidebar_openfiles_add(GeanyDocument *doc)
 	const GdkColor *color = document_get_status_color(doc);
 	static GIcon *file_icon = NULL;
 
+	if (main_status.opening_session_files)
+		openfiles_suspend_sorting();
+
 	gtk_tree_store_append(store_openfiles, iter, parent);
 
 	/* check if new parent */
@@ -500,7 +538,15 @@ static void openfiles_remove(GeanyDocument *doc)
 
 	if (gtk_tree_model_iter_parent(GTK_TREE_MODEL(store_openfiles), &parent, iter) &&
 		gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store_openfiles), &parent) == 1)
+	{
+		gchar *dirname;
+
+		gtk_tree_model_get(GTK_TREE_MODEL(store_openfiles), &parent, DOCUMENTS_SHORTNAME, &dirname, -1);
+		SETPTR(dirname, get_dir_key(dirname));
+		g_hash_table_remove(openfiles_dirs, dirname);
+		g_free(dirname);
 		gtk_tree_store_remove(store_openfiles, &parent);
+	}
 	else
 		gtk_tree_store_remove(store_openfiles, iter);
 }
@@ -545,11 +591,14 @@ void sidebar_openfiles_update_all(void)
 {
 	guint i;
 
+	openfiles_suspend_sorting();
 	gtk_tree_store_clear(store_openfiles);
+	g_hash_table_remove_all(openfiles_dirs);
 	foreach_document (i)
 	{
 		sidebar_openfiles_add(documents[i]);
 	}
+	openfiles_resume_sorting();
 }
 
 
@@ -777,31 +826,16 @@ static void unfold_parent(GtkTreeIter *iter)
 }
 
 
-/* compares the given data with the doc pointer from the selected row of openfiles
- * treeview, in case of a match the row is selected and TRUE is returned
- * (called indirectly from gtk_tree_model_foreach()) */
-static gboolean tree_model_find_node(GtkTreeModel *model, GtkTreePath *path,
-		GtkTreeIter *iter, gpointer data)
-{
-	GeanyDocument *doc;
-
-	gtk_tree_model_get(GTK_TREE_MODEL(store_openfiles), iter, DOCUMENTS_DOCUMENT, &doc, -1);
-
-	if (doc == data)
-	{
-		/* unfolding also prevents a strange bug where the selection gets stuck on the parent
-		 * when it is collapsed and then switching documents */
-		unfold_parent(iter);
-		gtk_tree_view_set_cursor(GTK_TREE_VIEW(tv.tree_openfiles), path, NULL, FALSE);
-		return TRUE;
-	}
-	else return FALSE;
-}
-
-
+/* selects the row of doc, set by sidebar_openfiles_add() */
 void sidebar_select_openfiles_item(GeanyDocument *doc)
 {
-	gtk_tree_model_foreach(GTK_TREE_MODEL(store_openfiles), tree_model_find_node, doc);
+	GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(store_openfiles), &doc->priv->iter);
+
+	/* unfolding also prevents a strange bug where the selection gets stuck on the parent
+	 * when it is collapsed and then switching documents */
+	unfold_parent(&doc->priv->iter);
+	gtk_tree_view_set_cursor(GTK_TREE_VIEW(tv.tree_openfiles), path, NULL, FALSE);
+	gtk_tree_path_free(path);
 }
 
 
@@ -1135,6 +1169,9 @@ void sidebar_finalize(void)
 		gtk_widget_destroy(tv.popup_taglist);
 	if (WIDGET(openfiles_popup_menu))
 		gtk_widget_destroy(openfiles_popup_menu);
+	if (openfiles_sort_idle_id != 0)
+		g_source_remove(openfiles_sort_idle_id);
+	g_hash_table_destroy(openfiles_dirs);
 }
 
 
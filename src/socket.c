@@ -59,6 +59,7 @@
 #include "socket.h"
 
 #include "app.h"
+#include "callbacks.h"
 #include "dialogs.h"
 #include "document.h"
 #include "encodings.h"
@@ -653,6 +654,7 @@ gboolean socket_lock_input_cb(GIOChannel *source, GIOCondition condition, gpoint
 	socklen_t caddr_len = sizeof(caddr);
 	GtkWidget *window = data;
 	gboolean popup = FALSE;
+	gboolean opened_files = FALSE;
 
 	fd = g_io_channel_unix_get_fd(source);
 	sock = accept(fd, (struct sockaddr *)&caddr, &caddr_len);
@@ -674,7 +676,11 @@ gboolean socket_lock_input_cb(GIOChannel *source, GIOCondition condition, gpoint
 				if (buf_len > 0 && buf[buf_len - 1] == '\n')
 					buf[buf_len - 1] = '\0';
 
+				/* like on startup, skip updating the UI for each tab when opening many
+				 * files at once (set for each file as opening a project resets it) */
+				main_status.opening_session_files = TRUE;
 				handle_input_filename(buf);
+				opened_files = TRUE;
 			}
 			popup = TRUE;
 		}
@@ -719,6 +725,10 @@ gboolean socket_lock_input_cb(GIOChannel *source, GIOCondition condition, gpoint
 #endif
 	}
 
+	/* update the UI once for the current document, also unsets opening_session_files */
+	if (opened_files)
+		callbacks_finish_opening_files(-1);
+
 	if (popup)
 	{
 #ifdef GDK_WINDOWING_X11
@@ -71,6 +71,15 @@ typedef struct
 } TreeSearchData;
 
 
+/* a symbol tree row whose tag has changed, see update_tree_tags() */
+typedef struct
+{
+	GtkTreeIter iter;
+	TMTag *tag;       /* the new tag for the row */
+	gboolean found_parent;
+} TagRowUpdate;
+
+
 static GPtrArray *top_level_iter_names = NULL;
 
 enum
@@ -421,6 +430,19 @@ tag_list_add_groups(GtkTreeStore *tree_store, ...)
 
 	g_return_if_fail(top_level_iter_names);
 
+	/* collect all the titles first, the store may be sorted and compare a new row
+	 * against any of them */
+	va_start(args, tree_store);
+	for (; iter = va_arg(args, GtkTreeIter*), iter != NULL;)
+	{
+		gchar *title = va_arg(args, gchar*);
+
+		va_arg(args, guint);
+		g_assert(title != NULL);
+		g_ptr_array_add(top_level_iter_names, title);
+	}
+	va_end(args);
+
 	va_start(args, tree_store);
 	for (; iter = va_arg(args, GtkTreeIter*), iter != NULL;)
 	{
@@ -431,9 +453,6 @@ tag_list_add_groups(GtkTreeStore *tree_store, ...)
 		if (icon_id < N_ICONS)
 			icon = symbols_icons[icon_id].pixbuf;
 
-		g_assert(title != NULL);
-		g_ptr_array_add(top_level_iter_names, title);
-
 		if (!find_toplevel_iter(tree_store, iter, title))
 			gtk_tree_store_append(tree_store, iter, NULL);
 
@@ -1315,15 +1334,26 @@ static void tags_table_value_free(gpointer data)
  *   on each tag;
  * - the other holding "tag-name":row references for tags having children, used to
  *   lookup for a parent in both passes, avoiding tree traversal.
+ *
+ * If @sorted is TRUE the store is sorted and kept so, changed rows are then only
+ * updated after the first pass as setting their name may move them. This relies on
+ * tree_sort_func() only depending on the compared rows themselves, so that setting one
+ * row only moves that row. Returns whether
+ * the store is still sorted, it is cheaper to sort it again in full when there are
+ * many rows to insert.
  */
-static void update_tree_tags(GeanyDocument *doc, GList **tags)
+static gboolean update_tree_tags(GeanyDocument *doc, GList **tags, gboolean sorted)
 {
 	GtkTreeStore *store = doc->priv->tag_store;
 	GtkTreeModel *model = GTK_TREE_MODEL(store);
 	GHashTable *parents_table;
 	GHashTable *tags_table;
+	GArray *updates;
 	GtkTreeIter iter;
 	gboolean cont;
+	gboolean backwards = FALSE;
+	guint n_rows = 0;
+	guint i;
 	GList *item;
 
 	/* Build hash tables holding tags and parents */
@@ -1334,6 +1364,7 @@ static void update_tree_tags(GeanyDocument *doc, GList **tags)
 	/* tags table is another representation of the @tags list,
 	 * GHashTable<TMTag, GTree<line_num, GList<GList<TMTag>>>> */
 	tags_table = g_hash_table_new_full(tag_hash, tag_equal, NULL, tags_table_value_free);
+	updates = g_array_new(FALSE, FALSE, sizeof(TagRowUpdate));
 	foreach_list(item, *tags)
 	{
 		TMTag *tag = item->data;
@@ -1377,22 +1408,19 @@ static void update_tree_tags(GeanyDocument *doc, GList **tags)
 
 				if (!tm_tags_equal(tag, found))
 				{
-					const gchar *name;
-					gchar *tooltip;
-
-					/* only update fields that (can) have changed (name that holds line
-					 * number, tooltip, and the tag itself) */
-					name = get_symbol_name(doc, found, parent_name != NULL);
-					tooltip = get_symbol_tooltip(doc, found);
-					gtk_tree_store_set(store, &iter,
-							SYMBOLS_COLUMN_NAME, name,
-							SYMBOLS_COLUMN_TOOLTIP, tooltip,
-							SYMBOLS_COLUMN_TAG, found,
-							-1);
-					g_free(tooltip);
+					TagRowUpdate update;
+
+					update.iter = iter;
+					update.tag = found;
+					update.found_parent = parent_name != NULL;
+					/* guess in which direction the lines moved, see below */
+					if (updates->len == 0)
+						backwards = found->line > tag->line;
+					g_array_append_val(updates, update);
 				}
 
 				update_parents_table(parents_table, found, &iter);
+				n_rows++;
 
 				/* remove the updated tag from the table and list */
 				tags_table_remove(tags_table, found);
@@ -1405,6 +1433,38 @@ static void update_tree_tags(GeanyDocument *doc, GList **tags)
 		}
 	}
 
+	/* each new row is moved into place by walking its siblings in a sorted store,
+	 * so with many new rows sort the tree in full at the end instead */
+	if (sorted && g_list_length(*tags) > g_bit_storage(n_rows))
+	{
+		gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store),
+			GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, 0);
+		sorted = FALSE;
+	}
+
+	/* Update the changed rows. In a sorted store each update moves only its own row and
+	 * keeps the siblings sorted, so any order is correct. As an optimisation, when lines were
+	 * inserted start from the last row, so that rows moving down mostly don't have to pass
+	 * rows which are moved later on anyway */
+	for (i = 0; i < updates->len; i++)
+	{
+		TagRowUpdate *update = &g_array_index(updates, TagRowUpdate,
+			backwards ? updates->len - 1 - i : i);
+		const gchar *name;
+		gchar *tooltip;
+
+		/* only update fields that (can) have changed (name that holds line
+		 * number, tooltip, and the tag itself) */
+		name = get_symbol_name(doc, update->tag, update->found_parent);
+		tooltip = get_symbol_tooltip(doc, update->tag);
+		gtk_tree_store_set(store, &update->iter,
+				SYMBOLS_COLUMN_NAME, name,
+				SYMBOLS_COLUMN_TOOLTIP, tooltip,
+				SYMBOLS_COLUMN_TAG, update->tag,
+				-1);
+		g_free(tooltip);
+	}
+
 	/* Second pass, now we have a tree cleaned up from invalid rows,
 	 * we simply add new ones */
 	foreach_list (item, *tags)
@@ -1460,6 +1520,9 @@ static void update_tree_tags(GeanyDocument *doc, GList **tags)
 
 	g_hash_table_destroy(parents_table);
 	g_hash_table_destroy(tags_table);
+	g_array_free(updates, TRUE);
+
+	return sorted;
 }
 
 
@@ -1496,6 +1559,9 @@ static gboolean tag_has_missing_parent(const TMTag *tag, GtkTreeStore *store,
 }
 
 
+/* The sort key of a row must only depend on its own columns and depth (not e.g. on its
+ * siblings or on the parent's tag), update_tree_tags() relies on it to keep the store sorted
+ * while it changes rows one at a time. tests/test_symbols.c checks this. */
 static gint tree_sort_func(GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b,
 		gpointer user_data)
 {
@@ -1567,6 +1633,8 @@ static void sort_tree(GtkTreeStore *store, gboolean sort_by_name)
 gboolean symbols_recreate_tag_list(GeanyDocument *doc, gint sort_mode)
 {
 	GList *tags;
+	gint sort_column;
+	gboolean sorted;
 
 	g_return_val_if_fail(DOC_VALID(doc), FALSE);
 
@@ -1576,22 +1644,30 @@ gboolean symbols_recreate_tag_list(GeanyDocument *doc, gint sort_mode)
 
 	/* FIXME: Not sure why we detached the model here? */
 
-	/* disable sorting during update because the code doesn't support correctly
+	if (sort_mode == SYMBOLS_SORT_USE_PREVIOUS)
+		sort_mode = doc->priv->symbol_list_sort_mode;
+
+	/* a tree already sorted the same way is kept sorted during the update, as sorting
+	 * it in full costs more than the update itself on large files */
+	sorted = sort_mode == doc->priv->symbol_list_sort_mode &&
+		gtk_tree_sortable_get_sort_column_id(GTK_TREE_SORTABLE(doc->priv->tag_store),
+			&sort_column, NULL) && sort_column == SYMBOLS_COLUMN_NAME;
+
+	/* otherwise disable sorting during update because the code doesn't support correctly
 	 * models that are currently being built */
-	gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(doc->priv->tag_store), GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, 0);
+	if (!sorted)
+		gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(doc->priv->tag_store), GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, 0);
 
 	/* add grandparent type iters */
 	add_top_level_items(doc);
 
-	update_tree_tags(doc, &tags);
+	sorted = update_tree_tags(doc, &tags, sorted);
 	g_list_free(tags);
 
 	hide_empty_rows(doc->priv->tag_store);
 
-	if (sort_mode == SYMBOLS_SORT_USE_PREVIOUS)
-		sort_mode = doc->priv->symbol_list_sort_mode;
-
-	sort_tree(doc->priv->tag_store, sort_mode == SYMBOLS_SORT_BY_NAME);
+	if (!sorted)
+		sort_tree(doc->priv->tag_store, sort_mode == SYMBOLS_SORT_BY_NAME);
 	doc->priv->symbol_list_sort_mode = sort_mode;
 
 	return TRUE;
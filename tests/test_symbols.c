@@ -0,0 +1,289 @@
+/*
+ *      test_symbols.c - this file is part of Geany, a fast and lightweight IDE
+ *
+ *      Copyright 2026 The Geany contributors
+ *
+ *      This program is free software; you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation; either version 2 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License along
+ *      with this program; if not, write to the Free Software Foundation, Inc.,
+ *      51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Checks that updating an already sorted symbol list gives the same rows in the same
+ * order as sorting the list in full.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "app.h"
+#include "document.h"
+#include "documentprivate.h"
+#include "editor.h"
+#include "filetypes.h"
+#include "sidebar.h"
+#include "symbols.h"
+#include "tm_source_file.h"
+#include "tm_tag.h"
+
+#include <string.h>
+
+#include <gtk/gtk.h>
+#include <glib/gstdio.h>
+
+
+typedef struct
+{
+	const gchar *name;
+	const gchar *scope;
+	TMTagType type;
+	gulong line;
+} TestTag;
+
+
+/* enough functions that adding a few rows keeps the sorted store, see update_tree_tags() */
+#define FUNCTIONS(line) \
+	{ "f00", NULL, tm_tag_function_t, (line) + 0 }, \
+	{ "f01", NULL, tm_tag_function_t, (line) + 2 }, \
+	{ "f02", NULL, tm_tag_function_t, (line) + 4 }, \
+	{ "f03", NULL, tm_tag_function_t, (line) + 6 }, \
+	{ "f04", NULL, tm_tag_function_t, (line) + 8 }, \
+	{ "f05", NULL, tm_tag_function_t, (line) + 10 }, \
+	{ "f06", NULL, tm_tag_function_t, (line) + 12 }, \
+	{ "f07", NULL, tm_tag_function_t, (line) + 14 }, \
+	{ "f08", NULL, tm_tag_function_t, (line) + 16 }, \
+	{ "f09", NULL, tm_tag_function_t, (line) + 18 }, \
+	{ "f10", NULL, tm_tag_function_t, (line) + 20 }, \
+	{ "f11", NULL, tm_tag_function_t, (line) + 22 }, \
+	{ "f12", NULL, tm_tag_function_t, (line) + 24 }, \
+	{ "f13", NULL, tm_tag_function_t, (line) + 26 }, \
+	{ "f14", NULL, tm_tag_function_t, (line) + 28 }, \
+	{ "f15", NULL, tm_tag_function_t, (line) + 30 }
+
+static const TestTag tags_initial[] = {
+	{ "A", NULL, tm_tag_class_t, 1 },
+	{ "a1", "A", tm_tag_member_t, 2 },
+	{ "a2", "A", tm_tag_function_t, 5 },
+	{ "B", NULL, tm_tag_class_t, 10 },
+	{ "b1", "B", tm_tag_member_t, 11 },
+	{ "b2", "B", tm_tag_function_t, 12 },
+	FUNCTIONS(100),
+	{ NULL }
+};
+
+/* class A was removed, its former members are now listed with their scope */
+static const TestTag tags_parent_removed[] = {
+	{ "a1", "A", tm_tag_member_t, 1 },
+	{ "a2", "A", tm_tag_function_t, 3 },
+	{ "B", NULL, tm_tag_class_t, 8 },
+	{ "b1", "B", tm_tag_member_t, 9 },
+	{ "b2", "B", tm_tag_function_t, 10 },
+	FUNCTIONS(97),
+	{ NULL }
+};
+
+/* class A is back, after some lines were inserted above it */
+static const TestTag tags_parent_restored[] = {
+	{ "A", NULL, tm_tag_class_t, 4 },
+	{ "a1", "A", tm_tag_member_t, 5 },
+	{ "a2", "A", tm_tag_function_t, 8 },
+	{ "B", NULL, tm_tag_class_t, 13 },
+	{ "b1", "B", tm_tag_member_t, 14 },
+	{ "b2", "B", tm_tag_function_t, 15 },
+	FUNCTIONS(103),
+	{ NULL }
+};
+
+/* lines moved in both directions: class B moved to the end, a function moved up */
+static const TestTag tags_moved[] = {
+	{ "A", NULL, tm_tag_class_t, 4 },
+	{ "a1", "A", tm_tag_member_t, 5 },
+	{ "a2", "A", tm_tag_function_t, 8 },
+	{ "f15", NULL, tm_tag_function_t, 9 },
+	{ "f00", NULL, tm_tag_function_t, 20 },
+	{ "f01", NULL, tm_tag_function_t, 22 },
+	{ "f02", NULL, tm_tag_function_t, 24 },
+	{ "f03", NULL, tm_tag_function_t, 26 },
+	{ "f04", NULL, tm_tag_function_t, 28 },
+	{ "f05", NULL, tm_tag_function_t, 30 },
+	{ "f06", NULL, tm_tag_function_t, 32 },
+	{ "f07", NULL, tm_tag_function_t, 34 },
+	{ "f08", NULL, tm_tag_function_t, 36 },
+	{ "f09", NULL, tm_tag_function_t, 38 },
+	{ "f10", NULL, tm_tag_function_t, 40 },
+	{ "f11", NULL, tm_tag_function_t, 42 },
+	{ "f12", NULL, tm_tag_function_t, 44 },
+	{ "f13", NULL, tm_tag_function_t, 46 },
+	{ "f14", NULL, tm_tag_function_t, 48 },
+	{ "B", NULL, tm_tag_class_t, 60 },
+	{ "b1", "B", tm_tag_member_t, 61 },
+	{ "b2", "B", tm_tag_function_t, 62 },
+	{ NULL }
+};
+
+static const TestTag *const tag_sets[] = {
+	tags_parent_removed, tags_parent_restored, tags_moved, tags_initial, tags_moved
+};
+
+
+typedef struct
+{
+	GeanyDocument doc;
+	GeanyDocumentPrivate priv;
+	GeanyEditor editor;
+	TMSourceFile source_file;
+}
+Fixture;
+
+
+static void set_tags(Fixture *fixture, const TestTag *test_tags)
+{
+	GPtrArray *tags_array = fixture->source_file.tags_array;
+
+	g_ptr_array_set_size(tags_array, 0);
+	for (; test_tags->name; test_tags++)
+	{
+		TMTag *tag = tm_tag_new();
+
+		tag->name = g_strdup(test_tags->name);
+		tag->scope = g_strdup(test_tags->scope);
+		tag->type = test_tags->type;
+		tag->line = test_tags->line;
+		tag->lang = fixture->source_file.lang;
+		g_ptr_array_add(tags_array, tag);
+	}
+}
+
+
+static void fixture_setup(Fixture *fixture, G_GNUC_UNUSED gconstpointer data)
+{
+	GeanyDocument *doc = &fixture->doc;
+
+	memset(fixture, 0, sizeof *fixture);
+	fixture->source_file.lang = filetypes[GEANY_FILETYPES_CPP]->lang;
+	fixture->source_file.tags_array = g_ptr_array_new_with_free_func((GDestroyNotify) tm_tag_unref);
+
+	fixture->editor.document = doc;
+	doc->priv = &fixture->priv;
+	doc->editor = &fixture->editor;
+	doc->encoding = (gchar *) "UTF-8";
+	doc->file_type = filetypes[GEANY_FILETYPES_CPP];
+	doc->tm_file = &fixture->source_file;
+
+	doc->priv->tag_store = gtk_tree_store_new(SYMBOLS_N_COLUMNS,
+		GDK_TYPE_PIXBUF, G_TYPE_STRING, TM_TYPE_TAG, G_TYPE_STRING);
+	doc->priv->tag_tree = g_object_ref_sink(
+		gtk_tree_view_new_with_model(GTK_TREE_MODEL(doc->priv->tag_store)));
+}
+
+
+static void fixture_teardown(Fixture *fixture, G_GNUC_UNUSED gconstpointer data)
+{
+	g_object_unref(fixture->priv.tag_tree);
+	g_object_unref(fixture->priv.tag_store);
+	g_ptr_array_free(fixture->source_file.tags_array, TRUE);
+}
+
+
+static void append_rows(GString *str, GtkTreeModel *model, GtkTreeIter *parent, guint depth)
+{
+	GtkTreeIter iter;
+	gboolean cont;
+
+	for (cont = gtk_tree_model_iter_children(model, &iter, parent); cont;
+		 cont = gtk_tree_model_iter_next(model, &iter))
+	{
+		gchar *name;
+
+		gtk_tree_model_get(model, &iter, SYMBOLS_COLUMN_NAME, &name, -1);
+		g_string_append_printf(str, "%*s%s\n", (gint) depth * 2, "", name);
+		g_free(name);
+		append_rows(str, model, &iter, depth + 1);
+	}
+}
+
+
+static gchar *dump_tree(GeanyDocument *doc)
+{
+	GString *str = g_string_new(NULL);
+
+	append_rows(str, GTK_TREE_MODEL(doc->priv->tag_store), NULL, 0);
+	return g_string_free(str, FALSE);
+}
+
+
+static void test_update_sorted(Fixture *fixture, gconstpointer data)
+{
+	GeanyDocument *doc = &fixture->doc;
+	gint sort_mode = GPOINTER_TO_INT(data);
+	gint other_mode = sort_mode == SYMBOLS_SORT_BY_NAME ?
+		SYMBOLS_SORT_BY_APPEARANCE : SYMBOLS_SORT_BY_NAME;
+	guint i;
+
+	doc->priv->symbol_list_sort_mode = sort_mode;
+	set_tags(fixture, tags_initial);
+	g_assert(symbols_recreate_tag_list(doc, sort_mode));
+
+	for (i = 0; i < G_N_ELEMENTS(tag_sets); i++)
+	{
+		gchar *updated, *sorted;
+
+		/* same sort mode, so the store is kept sorted while it is updated */
+		set_tags(fixture, tag_sets[i]);
+		g_assert(symbols_recreate_tag_list(doc, sort_mode));
+		updated = dump_tree(doc);
+
+		/* changing the sort mode sorts the same rows in full */
+		g_assert(symbols_recreate_tag_list(doc, other_mode));
+		g_assert(symbols_recreate_tag_list(doc, sort_mode));
+		sorted = dump_tree(doc);
+
+		g_assert_cmpstr(updated, ==, sorted);
+		g_free(updated);
+		g_free(sorted);
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	gchar *dir;
+	gint ret;
+
+	g_test_init(&argc, &argv, NULL);
+	if (! gtk_init_check(&argc, &argv))
+	{
+		g_message("no display available, skipping");
+		return 77;
+	}
+
+	/* no user or system filetype configuration is read */
+	dir = g_dir_make_tmp("geany-test-XXXXXX", NULL);
+	g_assert(dir != NULL);
+	app = g_new0(GeanyApp, 1);
+	app->datadir = dir;
+	app->configdir = dir;
+	filetypes_init_types();
+
+	g_test_add("/symbols/update-sorted-by-name", Fixture,
+		GINT_TO_POINTER(SYMBOLS_SORT_BY_NAME), fixture_setup, test_update_sorted, fixture_teardown);
+	g_test_add("/symbols/update-sorted-by-appearance", Fixture,
+		GINT_TO_POINTER(SYMBOLS_SORT_BY_APPEARANCE), fixture_setup, test_update_sorted, fixture_teardown);
+
+	ret = g_test_run();
+
+	g_rmdir(dir);
+	g_free(dir);
+	return ret;
+}